@@ -0,0 +1,230 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Printer of circuit specific C++ gate evaluators for the placeholder prover.
+//---------------------------------------------------------------------------//
+#ifndef __GATES_EVALUATOR_CPP_GEN_HPP__
+#define __GATES_EVALUATOR_CPP_GEN_HPP__
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <nil/blueprint/transpiler/templates/gates_evaluator.hpp>
+#include <nil/blueprint/transpiler/util.hpp>
+
+namespace nil {
+    namespace blueprint {
+        /**
+         * Prints a C++ translation unit with a straight-line evaluator of all the gates of a constraint system.
+         * The evaluator registers itself in the compiled_gates_evaluators of the parallel prover under
+         * the constraint_system_with_params_hash, and the prover then uses it instead of interpreting
+         * the gate expressions. It computes the same sum as placeholder_gates_argument::prove_eval:
+         * sum over the gates of selector * sum(theta^k * constraint_k).
+         */
+        template <typename PlaceholderParams>
+        class gates_evaluator_cpp_printer {
+            using field_type = typename PlaceholderParams::field_type;
+            using value_type = typename field_type::value_type;
+            using variable_type = nil::crypto3::zk::snark::plonk_variable<value_type>;
+            using expression_type = crypto3::math::expression<variable_type>;
+
+            // Prints an expression as a C++ expression over the values 'v' and the constants.
+            class expression_printer : public boost::static_visitor<std::string> {
+            public:
+                expression_printer(gates_evaluator_cpp_printer& printer) : printer(printer) {
+                }
+
+                std::string operator()(const crypto3::math::term<variable_type>& term) {
+                    std::vector<std::string> factors;
+                    if (term.get_coeff() != value_type::one() || term.get_vars().empty()) {
+                        factors.push_back(printer.constant_name(term.get_coeff()));
+                    }
+                    for (const variable_type& var : term.get_vars()) {
+                        factors.push_back("v[" + to_string(printer.variable_index(var)) + " * rows]");
+                    }
+                    return "(" + boost::algorithm::join(factors, " * ") + ")";
+                }
+
+                std::string operator()(const crypto3::math::pow_operation<variable_type>& pow) {
+                    return "(" + boost::apply_visitor(*this, pow.get_expr().get_expr()) + ").pow(" +
+                        to_string(pow.get_power()) + ")";
+                }
+
+                std::string operator()(const crypto3::math::binary_arithmetic_operation<variable_type>& op) {
+                    std::string left = boost::apply_visitor(*this, op.get_expr_left().get_expr());
+                    std::string right = boost::apply_visitor(*this, op.get_expr_right().get_expr());
+                    switch (op.get_op()) {
+                        case crypto3::math::ArithmeticOperator::ADD:
+                            return "(" + left + " + " + right + ")";
+                        case crypto3::math::ArithmeticOperator::SUB:
+                            return "(" + left + " - " + right + ")";
+                        case crypto3::math::ArithmeticOperator::MULT:
+                            return "(" + left + " * " + right + ")";
+                        default:
+                            throw std::invalid_argument("ArithmeticOperator not found");
+                    }
+                }
+
+            private:
+                gates_evaluator_cpp_printer& printer;
+            };
+
+        public:
+            /**
+             * @param field_type_name - C++ name of the field of the circuit in the printed code.
+             * @param includes - headers that declare that field.
+             */
+            gates_evaluator_cpp_printer(
+                const typename PlaceholderParams::constraint_system_type &constraint_system,
+                const std::string& constraint_system_hash,
+                const std::string& field_type_name,
+                const std::vector<std::string>& includes
+            ) :
+            _constraint_system(constraint_system),
+            _constraint_system_hash(constraint_system_hash),
+            _field_type_name(field_type_name),
+            _includes(includes) {
+            }
+
+            std::string generate() {
+                std::stringstream gates_code;
+                std::size_t constraints_count = 0;
+                for (const auto& gate : _constraint_system.gates()) {
+                    gates_code << "            // Gate with selector " << column_index_name(gate.selector_index) << std::endl;
+                    for (std::size_t i = 0; i < gate.constraints.size(); ++i) {
+                        expression_printer printer(*this);
+                        std::string constraint = boost::apply_visitor(printer, gate.constraints[i].get_expr());
+                        gates_code << "            gate " << (i == 0 ? "=" : "+=") << " theta_powers["
+                                   << constraints_count++ << "] * " << constraint << ";" << std::endl;
+                    }
+                    if (gate.constraints.empty()) {
+                        continue;
+                    }
+                    variable_type selector(gate.selector_index, 0, false, variable_type::column_type::selector);
+                    gates_code << "            F += gate * v[" << variable_index(selector) << " * rows];" << std::endl;
+                }
+
+                std::stringstream constants;
+                for (std::size_t i = 0; i < _constants.size(); ++i) {
+                    constants << "    const value_type c" << i << "(integral_type(\"" << _constants[i] << "\"));"
+                              << std::endl;
+                }
+
+                std::stringstream variables;
+                for (const variable_type& var : _variables) {
+                    variables << "            variable_type(" << column_index_name(var.index) << ", " << var.rotation << ", "
+                              << (var.relative ? "true" : "false") << ", variable_type::column_type::"
+                              << column_type_name(var.type) << ")," << std::endl;
+                }
+
+                std::stringstream includes;
+                for (const std::string& include : _includes) {
+                    includes << "#include <" << include << ">" << std::endl;
+                }
+
+                transpiler_replacements reps;
+                reps["$CONSTRAINT_SYSTEM_HASH$"] = _constraint_system_hash;
+                reps["$INCLUDES$"] = includes.str();
+                reps["$FIELD_TYPE$"] = _field_type_name;
+                reps["$CONSTANTS$"] = constants.str();
+                reps["$GATES_CODE$"] = gates_code.str();
+                reps["$VARIABLES$"] = variables.str();
+                reps["$CONSTRAINTS_COUNT$"] = to_string(constraints_count);
+                return replace_all(gates_evaluator_cpp_template, reps);
+            }
+
+            void print(const std::string& output_file_name) {
+                std::ofstream out;
+                out.open(output_file_name);
+                out << generate();
+                out.close();
+            }
+
+        private:
+            std::size_t variable_index(const variable_type& var) {
+                auto it = _variable_indices.find(var);
+                if (it != _variable_indices.end()) {
+                    return it->second;
+                }
+                _variable_indices[var] = _variables.size();
+                _variables.push_back(var);
+                return _variables.size() - 1;
+            }
+
+            std::string constant_name(const value_type& value) {
+                auto it = _constant_indices.find(value);
+                if (it != _constant_indices.end()) {
+                    return "c" + to_string(it->second);
+                }
+                _constant_indices[value] = _constants.size();
+                _constants.push_back(value);
+                return "c" + to_string(_constants.size() - 1);
+            }
+
+            static std::string column_index_name(std::size_t index) {
+                if (index == crypto3::zk::snark::PLONK_SPECIAL_SELECTOR_ALL_USABLE_ROWS_SELECTED) {
+                    return "nil::crypto3::zk::snark::PLONK_SPECIAL_SELECTOR_ALL_USABLE_ROWS_SELECTED";
+                }
+                if (index == crypto3::zk::snark::PLONK_SPECIAL_SELECTOR_ALL_NON_FIRST_USABLE_ROWS_SELECTED) {
+                    return "nil::crypto3::zk::snark::PLONK_SPECIAL_SELECTOR_ALL_NON_FIRST_USABLE_ROWS_SELECTED";
+                }
+                return to_string(index);
+            }
+
+            static std::string column_type_name(typename variable_type::column_type type) {
+                switch (type) {
+                    case variable_type::column_type::witness:
+                        return "witness";
+                    case variable_type::column_type::public_input:
+                        return "public_input";
+                    case variable_type::column_type::constant:
+                        return "constant";
+                    case variable_type::column_type::selector:
+                        return "selector";
+                    default:
+                        throw std::invalid_argument("Invalid column type");
+                }
+            }
+
+            const typename PlaceholderParams::constraint_system_type &_constraint_system;
+            std::string _constraint_system_hash;
+            std::string _field_type_name;
+            std::vector<std::string> _includes;
+
+            std::vector<variable_type> _variables;
+            std::map<variable_type, std::size_t> _variable_indices;
+            std::vector<value_type> _constants;
+            std::unordered_map<value_type, std::size_t> _constant_indices;
+        };
+    }
+}
+
+#endif //__GATES_EVALUATOR_CPP_GEN_HPP__
@@ -0,0 +1,48 @@
+#ifndef __GATES_EVALUATOR_CPP_TEMPLATE_HPP__
+#define __GATES_EVALUATOR_CPP_TEMPLATE_HPP__
+
+#include <string>
+
+namespace nil {
+    namespace blueprint {
+        std::string gates_evaluator_cpp_template = R"(
+//---------------------------------------------------------------------------//
+// Generated by ZKLLVM-transpiler
+//
+// Gate evaluator of the constraint system with hash $CONSTRAINT_SYSTEM_HASH$.
+// Link it into the prover, or load it, to evaluate the gates of this constraint system
+// with the code below instead of interpreting their expressions.
+//---------------------------------------------------------------------------//
+$INCLUDES$
+#include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/compiled_gates_evaluator.hpp>
+
+namespace {
+    using field_type = $FIELD_TYPE$;
+    using value_type = typename field_type::value_type;
+    using integral_type = typename field_type::integral_type;
+    using evaluators_type = nil::crypto3::zk::snark::compiled_gates_evaluators<field_type>;
+    using variable_type = typename evaluators_type::evaluator_type::variable_type;
+
+$CONSTANTS$
+    void evaluate_gates(const value_type* values, std::size_t rows, const value_type* theta_powers, value_type* result) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            const value_type* v = values + r;
+            value_type F = value_type::zero();
+            value_type gate;
+$GATES_CODE$
+            result[r] = F;
+        }
+    }
+
+    const bool registered = (evaluators_type::instance().add(
+        "$CONSTRAINT_SYSTEM_HASH$",
+        {{
+$VARIABLES$
+        }, $CONSTRAINTS_COUNT$, &evaluate_gates}), true);
+}
+)";
+    }
+}
+
+#endif //__GATES_EVALUATOR_CPP_TEMPLATE_HPP__
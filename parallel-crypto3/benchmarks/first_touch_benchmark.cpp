@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE first_touch_benchmark
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
+#include <nil/crypto3/random/algebraic_engine.hpp>
+
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/gates_argument.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/gate.hpp>
+#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
+
+#include <nil/actor/core/first_touch_allocator.hpp>
+#include <nil/actor/core/pool_allocator.hpp>
+
+#include <nil/crypto3/bench/boost_test_benchmark.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::zk;
+using namespace nil::crypto3::zk::snark;
+
+template<typename Field, typename Allocator = std::allocator<typename Field::value_type>>
+math::polynomial_dfs<typename Field::value_type, Allocator> generate_random_polynomial(
+        std::size_t size, nil::crypto3::random::algebraic_engine<Field>& engine) {
+    math::polynomial_dfs<typename Field::value_type, Allocator> result(size - 1, size);
+    for (std::size_t i = 0; i < size; ++i) {
+        result[i] = engine();
+    }
+    return result;
+}
+
+struct F {
+    using curve_type = algebra::curves::bls12<381>;
+    using FieldType = typename curve_type::scalar_field_type;
+    using value_type = typename FieldType::value_type;
+
+    using hash_type = hashes::keccak_1600<256>;
+    using circuit_params_type = placeholder_circuit_params<FieldType>;
+    using lpc_params_type = commitments::list_polynomial_commitment_params<hash_type, hash_type, 2>;
+    using lpc_type = commitments::list_polynomial_commitment<FieldType, lpc_params_type>;
+    using lpc_scheme_type = typename commitments::lpc_commitment_scheme<lpc_type>;
+    using placeholder_params_type = placeholder_params<circuit_params_type, lpc_scheme_type>;
+    template<typename Allocator>
+    using gates_argument_type = placeholder_gates_argument<FieldType, placeholder_params_type, 1, Allocator>;
+    using transcript_type = typename gates_argument_type<std::allocator<value_type>>::transcript_type;
+    using variable_type = plonk_variable<value_type>;
+
+    const std::size_t SEED = 1337;
+    F() : alg_rnd_engine(SEED) {}
+    nil::crypto3::random::algebraic_engine<FieldType> alg_rnd_engine;
+
+    // Resizes a column 4 times, like the gate argument does, then runs one more fft over the resized column.
+    // The resize allocates the column, so with first_touch_allocator its pages are spread over the NUMA nodes
+    // the same way as the chunks of basic_radix2_fft.
+    template<typename Allocator>
+    void run_fft_benchmark(const std::string& name, std::map<std::string, boost::timer::cpu_timer>& timers) {
+        const std::size_t size = 1u << 20;
+        const std::size_t extended_size = size * 4;
+
+        auto domain = math::make_evaluation_domain<FieldType>(size);
+        auto extended_domain = math::make_evaluation_domain<FieldType>(extended_size);
+        auto polynomial = generate_random_polynomial<FieldType, Allocator>(size, alg_rnd_engine);
+
+        START_TIMER(name + "_resize")
+        polynomial.resize(extended_size, domain, extended_domain);
+        STOP_TIMER(name + "_resize")
+
+        START_TIMER(name + "_basic_radix2_fft")
+        math::detail::basic_radix2_fft<FieldType>(polynomial, extended_domain->get_domain_element(1));
+        STOP_TIMER(name + "_basic_radix2_fft")
+    }
+
+    // Evaluates the gates with the buffers of the columns on the cosets allocated by the allocator of
+    // 'GatesArgument'.
+    template<typename GatesArgument>
+    void run_prove_eval_benchmark(const std::string& name, std::map<std::string, boost::timer::cpu_timer>& timers) {
+        const std::size_t rows = 1u << 16;
+        const std::size_t witnesses = 8;
+
+        std::vector<math::polynomial_dfs<value_type>> witness_columns;
+        for (std::size_t i = 0; i < witnesses; ++i) {
+            witness_columns.emplace_back(generate_random_polynomial<FieldType>(rows, alg_rnd_engine));
+        }
+        std::vector<math::polynomial_dfs<value_type>> selector_columns;
+        for (std::size_t i = 0; i < witnesses / 2; ++i) {
+            selector_columns.emplace_back(generate_random_polynomial<FieldType>(rows, alg_rnd_engine));
+        }
+        plonk_polynomial_dfs_table<FieldType> columns(
+            std::make_shared<plonk_private_polynomial_dfs_table<FieldType>>(witness_columns),
+            std::make_shared<plonk_public_polynomial_dfs_table<FieldType>>(
+                std::vector<math::polynomial_dfs<value_type>>(),
+                std::vector<math::polynomial_dfs<value_type>>(),
+                selector_columns));
+
+        // Gates of degree 3 on pairs of witnesses, with rotations, so the coset buffers of the columns are read
+        // through the rotated views.
+        std::vector<plonk_gate<FieldType, plonk_constraint<FieldType>>> gates;
+        for (std::size_t i = 0; i + 1 < witnesses; i += 2) {
+            variable_type a(i, 0, true, variable_type::column_type::witness);
+            variable_type b(i + 1, 0, true, variable_type::column_type::witness);
+            variable_type b_next(i + 1, 1, true, variable_type::column_type::witness);
+            variable_type a_prev(i, -1, true, variable_type::column_type::witness);
+
+            plonk_constraint<FieldType> constraint = a * b * b_next - a_prev;
+            gates.emplace_back(i / 2, std::vector<plonk_constraint<FieldType>>{constraint});
+        }
+        plonk_constraint_system<FieldType> constraint_system(gates, {});
+
+        auto domain = math::make_evaluation_domain<FieldType>(rows);
+        math::polynomial_dfs<value_type> mask_polynomial(0, rows, value_type::one());
+        math::polynomial_dfs<value_type> lagrange_0(rows - 1, rows, value_type::zero());
+        lagrange_0[0] = value_type::one();
+
+        std::vector<std::uint8_t> init_blob{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        transcript_type transcript(init_blob);
+
+        START_TIMER(name + "_prove_eval")
+        GatesArgument::prove_eval(constraint_system, columns, domain, 3, mask_polynomial, lagrange_0, transcript);
+        STOP_TIMER(name + "_prove_eval")
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(first_touch_benchmark_test_suite, F)
+
+BENCHMARK_AUTO_TEST_CASE(basic_radix2_fft_std_allocator_test, 10) {
+    run_fft_benchmark<std::allocator<value_type>>("std_allocator", timers);
+}
+
+BENCHMARK_AUTO_TEST_CASE(basic_radix2_fft_first_touch_allocator_test, 10) {
+    run_fft_benchmark<first_touch_allocator<value_type>>("first_touch_allocator", timers);
+}
+
+// The coset buffers of prove_eval, from std::allocator, placed by first_touch_allocator, and recycled by
+// pool_allocator, the default.
+BENCHMARK_AUTO_TEST_CASE(gates_argument_prove_eval_std_allocator_test, 5) {
+    run_prove_eval_benchmark<gates_argument_type<std::allocator<value_type>>>("std_allocator", timers);
+}
+
+BENCHMARK_AUTO_TEST_CASE(gates_argument_prove_eval_first_touch_allocator_test, 5) {
+    run_prove_eval_benchmark<gates_argument_type<first_touch_allocator<value_type>>>("first_touch_allocator", timers);
+}
+
+BENCHMARK_AUTO_TEST_CASE(gates_argument_prove_eval_pool_allocator_test, 5) {
+    run_prove_eval_benchmark<gates_argument_type<pool_allocator<value_type>>>("pool_allocator", timers);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
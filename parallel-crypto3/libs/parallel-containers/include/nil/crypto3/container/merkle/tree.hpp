@@ -486,6 +486,26 @@ namespace nil {
                     return accumulators::extract::hash<T>(acc);
                 }
 
+                // Fills the rows above the leaves, the hashes of the leaves are already in 'ret'.
+                template<typename T, std::size_t Arity>
+                void make_merkle_tree_rows(merkle_tree_impl<T, Arity> &ret) {
+                    typedef typename T::hash_type hash_type;
+
+                    std::size_t row_idx = ret.leaves(), row_size = row_idx / Arity;
+                    typename merkle_tree_impl<T, Arity>::iterator it = ret.begin();
+
+                    std::size_t next_row_start_index = ret.leaves();
+
+                    for (size_t row_number = 1; row_number < ret.row_count(); ++row_number, row_size /= Arity) {
+                        nil::crypto3::parallel_for(0, row_size, [&ret, it, next_row_start_index](std::size_t index) {
+                            ret[next_row_start_index + index] = generate_hash<hash_type>(
+                                it + index * Arity, it + (index + 1) * Arity);
+                        });
+                        next_row_start_index += row_size;
+                        it += row_size * Arity;
+                    }
+                }
+
                 template<typename T, std::size_t Arity, typename LeafIterator>
                 merkle_tree_impl<T, Arity> make_merkle_tree(LeafIterator first, LeafIterator last) {
                     typedef T node_type;
@@ -500,19 +520,30 @@ namespace nil {
                         return static_cast<value_type>(crypto3::hash<hash_type>(leaf));
                     });
 
-                    std::size_t row_idx = ret.leaves(), row_size = row_idx / Arity;
-                    typename merkle_tree_impl<T, Arity>::iterator it = ret.begin();
+                    make_merkle_tree_rows(ret);
+                    return ret;
+                }
 
-                    std::size_t next_row_start_index = std::distance(first, last);
+                template<typename T, std::size_t Arity, typename Leaf, typename LeafFunc>
+                merkle_tree_impl<T, Arity> make_merkle_tree(std::size_t leaves_count, const Leaf &leaf,
+                                                            LeafFunc fill_leaf) {
+                    typedef T node_type;
+                    typedef typename node_type::hash_type hash_type;
+                    typedef typename node_type::value_type value_type;
 
-                    for (size_t row_number = 1; row_number < ret.row_count(); ++row_number, row_size /= Arity) {
-                        nil::crypto3::parallel_for(0, row_size, [&ret, it, next_row_start_index](std::size_t index) {
-                            ret[next_row_start_index + index] = generate_hash<hash_type>(
-                                it + index * Arity, it + (index + 1) * Arity);
+                    merkle_tree_impl<T, Arity> ret(leaves_count);
+                    ret.resize(ret.complete_size());
+
+                    nil::crypto3::parallel_for_chunks(leaves_count,
+                        [&ret, &leaf, &fill_leaf](std::size_t begin, std::size_t end) {
+                            Leaf chunk_leaf(leaf);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                fill_leaf(i, chunk_leaf);
+                                ret[i] = static_cast<value_type>(crypto3::hash<hash_type>(chunk_leaf));
+                            }
                         });
-                        next_row_start_index += row_size;
-                        it += row_size * Arity;
-                    }
+
+                    make_merkle_tree_rows(ret);
                     return ret;
                 }
             }    // namespace detail
@@ -530,6 +561,19 @@ namespace nil {
                         Arity>(first, last);
             }
 
+            /**
+             * Builds the tree of 'leaves_count' leaves without holding them all in memory. Each chunk of the
+             * leaves gets its own copy of 'leaf', 'fill_leaf(index, leaf)' writes the leaf 'index' into it, and
+             * the leaf is hashed right away.
+             */
+            template<typename T, std::size_t Arity, typename Leaf, typename LeafFunc>
+            merkle_tree<T, Arity> make_merkle_tree(std::size_t leaves_count, const Leaf &leaf, LeafFunc fill_leaf) {
+                return detail::make_merkle_tree<typename std::conditional<nil::crypto3::detail::is_hash<T>::value,
+                        detail::merkle_tree_node<T>,
+                        T>::type,
+                        Arity>(leaves_count, leaf, fill_leaf);
+            }
+
         }    // namespace containers
     }        // namespace crypto3
 }    // namespace nil
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
+#define PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * Replaces each element of [first, last) with its inverse, all the elements must be non-zero.
+             * Uses Montgomery's trick: each chunk is inverted with one field inversion and 3 multiplications
+             * per element, the chunks run in parallel.
+             */
+            template<typename RandomIt>
+            void batch_inversion(RandomIt first, RandomIt last,
+                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+                typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+                parallel_for_chunks(std::distance(first, last),
+                    [first](std::size_t begin, std::size_t end) {
+                        // prefix[i - begin] is the product of the elements [begin, i).
+                        std::vector<value_type> prefix(end - begin);
+                        value_type product = value_type::one();
+                        for (std::size_t i = begin; i < end; ++i) {
+                            BOOST_ASSERT_MSG(first[i] != value_type::zero(), "Can not invert zero");
+                            prefix[i - begin] = product;
+                            product *= first[i];
+                        }
+                        value_type inverse = product.inversed();
+                        for (std::size_t i = end; i-- > begin;) {
+                            value_type element_inverse = inverse * prefix[i - begin];
+                            inverse *= first[i];
+                            first[i] = element_inverse;
+                        }
+                    }, pool_id);
+            }
+
+            template<typename Range>
+            void batch_inversion(Range& values, ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+                batch_inversion(std::begin(values), std::end(values), pool_id);
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_MATH_FFT_HPP
+#define PARALLEL_CRYPTO3_MATH_FFT_HPP
+
+#ifdef CRYPTO3_MATH_FFT_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * FFT of 'a' on 'domain', for vectors with any allocator. The virtual fft of the evaluation domains takes
+             * std::vector only. Other vectors are transformed in place when the domain is a basic_radix2_domain,
+             * and through a std::vector copy otherwise.
+             */
+            template<typename FieldType, typename ValueType, typename Allocator>
+            void fft(std::shared_ptr<evaluation_domain<FieldType, ValueType>> domain,
+                     std::vector<ValueType, Allocator> &a) {
+                if constexpr (std::is_same<Allocator, std::allocator<ValueType>>::value) {
+                    domain->fft(a);
+                } else if (auto radix2 = std::dynamic_pointer_cast<basic_radix2_domain<FieldType, ValueType>>(domain)) {
+                    radix2->fft(a);
+                } else {
+                    std::vector<ValueType> tmp(a.begin(), a.end());
+                    domain->fft(tmp);
+                    a.assign(tmp.begin(), tmp.end());
+                }
+            }
+
+            template<typename FieldType, typename ValueType, typename Allocator>
+            void inverse_fft(std::shared_ptr<evaluation_domain<FieldType, ValueType>> domain,
+                             std::vector<ValueType, Allocator> &a) {
+                if constexpr (std::is_same<Allocator, std::allocator<ValueType>>::value) {
+                    domain->inverse_fft(a);
+                } else if (auto radix2 = std::dynamic_pointer_cast<basic_radix2_domain<FieldType, ValueType>>(domain)) {
+                    radix2->inverse_fft(a);
+                } else {
+                    std::vector<ValueType> tmp(a.begin(), a.end());
+                    domain->inverse_fft(tmp);
+                    a.assign(tmp.begin(), tmp.end());
+                }
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_MATH_FFT_HPP
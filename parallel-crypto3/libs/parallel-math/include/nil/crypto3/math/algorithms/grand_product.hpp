@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef PARALLEL_CRYPTO3_MATH_GRAND_PRODUCT_HPP
+#define PARALLEL_CRYPTO3_MATH_GRAND_PRODUCT_HPP
+
+#include <functional>
+#include <iterator>
+
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * Writes to d_first[i] the running product of numerators[j] / denominators[j], j <= i, for the
+             * numerators in [first, last), as in the grand product polynomials of the permutation and lookup
+             * arguments. The denominators are inverted in place with batch_inversion, one field inversion per
+             * chunk, and the running product is a parallel scan. d_first may be equal to first.
+             *
+             * Both input ranges are overwritten: the denominators hold their inverses and the numerators hold
+             * numerators[i] / denominators[i] on return. Callers that need them afterwards must pass copies.
+             */
+            template<typename InputIt, typename DenominatorIt, typename OutputIt>
+            void grand_product(InputIt first, InputIt last, DenominatorIt denominators_first, OutputIt d_first,
+                               ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+                typedef typename std::iterator_traits<InputIt>::value_type value_type;
+
+                const std::size_t count = std::distance(first, last);
+                batch_inversion(denominators_first, denominators_first + count, pool_id);
+                parallel_for_chunks(count,
+                    [first, denominators_first](std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            first[i] *= denominators_first[i];
+                        }
+                    }, pool_id);
+                parallel_inclusive_scan(first, last, d_first, std::multiplies<value_type>(), pool_id);
+            }
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_MATH_GRAND_PRODUCT_HPP
@@ -30,6 +30,10 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/domains/arithmetic_sequence_domain.hpp>
 #include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
@@ -164,6 +168,70 @@ namespace nil {
 
                 return result_type();
             }
+
+            /*!
+            @brief
+             Process-wide cache of the domains returned by make_evaluation_domain, keyed by the requested size.
+             The cached domains are shared by all the callers and threads, so they must not be modified. The radix-2
+             domains use the default FFT algorithm, which is fixed when a domain is constructed.
+             Their FFT twiddle tables live in detail::fft_twiddle_cache, which is accounted and cleared together
+             with the domains.
+            */
+            template<typename FieldType, typename ValueType = typename FieldType::value_type>
+            class evaluation_domain_cache {
+            public:
+                typedef std::shared_ptr<evaluation_domain<FieldType, ValueType>> domain_type;
+
+                static evaluation_domain_cache &instance() {
+                    static evaluation_domain_cache cache;
+                    return cache;
+                }
+
+                domain_type get(std::size_t m) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        auto it = domains.find(m);
+                        if (it != domains.end())
+                            return it->second;
+                    }
+
+                    // Created without holding the lock, building the twiddles runs on the thread pool.
+                    domain_type domain = make_evaluation_domain<FieldType, ValueType>(m);
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return domains.emplace(m, std::move(domain)).first->second;
+                }
+
+                // Returns the memory used by the twiddle tables of the domains in bytes, they are most of it.
+                std::size_t memory_usage() const {
+                    return detail::fft_twiddle_cache<FieldType>::instance().memory_usage();
+                }
+
+                // The domains already handed out stay valid.
+                void clear() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        domains.clear();
+                    }
+                    detail::fft_twiddle_cache<FieldType>::instance().clear();
+                }
+
+            private:
+                evaluation_domain_cache() = default;
+
+                std::mutex mutex;
+                std::map<std::size_t, domain_type> domains;
+            };
+
+            /*!
+            @brief
+             Same as make_evaluation_domain, but returns the domain of this size shared through
+             evaluation_domain_cache. The domain must not be modified.
+            */
+            template<typename FieldType, typename ValueType = typename FieldType::value_type>
+            std::shared_ptr<evaluation_domain<FieldType, ValueType>> get_evaluation_domain(std::size_t m) {
+                return evaluation_domain_cache<FieldType, ValueType>::instance().get(m);
+            }
         }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
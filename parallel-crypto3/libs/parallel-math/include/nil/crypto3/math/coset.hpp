@@ -29,8 +29,16 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/fft.hpp>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace math {
@@ -45,6 +53,83 @@ namespace nil {
                     u *= g;
                 }
             }
+
+            /**
+             * Evaluates the polynomial with the given coefficients on the cosets g * S of the domain S, one coset for
+             * each g of 'shifts'. Element j of the result for g is the value at g * omega^j, where omega is the unity
+             * root of S.
+             *
+             * The values of a polynomial of degree less than |S| on a domain k times larger, with the unity root w,
+             * are the cosets w^r * S, r < k: the value at w^(j * k + r) is element j of coset r. So a low degree
+             * extension costs k independent FFTs of size |S| instead of a zero-padded FFT on the large domain, and
+             * the callers that need only some of the cosets compute only those.
+             */
+            template<typename FieldType>
+            std::vector<std::vector<typename FieldType::value_type>> evaluate_on_cosets(
+                    const std::vector<typename FieldType::value_type> &coefficients,
+                    std::shared_ptr<evaluation_domain<FieldType>> domain,
+                    const std::vector<typename FieldType::value_type> &shifts) {
+                typedef typename FieldType::value_type value_type;
+
+                if (coefficients.size() != domain->size())
+                    throw std::invalid_argument("evaluate_on_cosets: expected coefficients.size() == domain->size()");
+
+                std::vector<std::vector<value_type>> cosets(shifts.size(), coefficients);
+                for (std::size_t r = 0; r < shifts.size(); ++r) {
+                    if (shifts[r] == value_type::one())
+                        continue;
+                    parallel_for_chunks(coefficients.size(),
+                        [&coset = cosets[r], &g = shifts[r]](std::size_t begin, std::size_t end) {
+                            value_type u = g.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                coset[i] *= u;
+                                u *= g;
+                            }
+                        }, ThreadPool::PoolLevel::HIGH);
+                }
+                domain->fft_batch(cosets);
+                return cosets;
+            }
+
+            /**
+             * Evaluates the polynomial with the given coefficients on the coset g * S of the domain S, see
+             * evaluate_on_cosets. 'values' is resized to |S|, so one buffer can be reused for all the cosets of a
+             * low degree extension instead of holding all of them at once.
+             *
+             * The number of coefficients may be any multiple of |S|. On g * S the power x^|S| is the constant g^|S|,
+             * so the coefficients of the higher powers are folded into the first |S| ones before the FFT.
+             */
+            template<typename FieldType, typename CoefficientsAllocator, typename ValuesAllocator>
+            void evaluate_on_coset(
+                    const std::vector<typename FieldType::value_type, CoefficientsAllocator> &coefficients,
+                    std::shared_ptr<evaluation_domain<FieldType>> domain,
+                    const typename FieldType::value_type &shift,
+                    std::vector<typename FieldType::value_type, ValuesAllocator> &values) {
+                typedef typename FieldType::value_type value_type;
+
+                const std::size_t size = domain->size();
+                if (coefficients.size() == 0 || coefficients.size() % size != 0)
+                    throw std::invalid_argument(
+                        "evaluate_on_coset: expected coefficients.size() to be a multiple of domain->size()");
+
+                const value_type shift_to_size = shift.pow(size);
+                values.resize(size);
+                parallel_for_chunks(size,
+                    [&coefficients, &values, &shift, &shift_to_size, size](std::size_t begin, std::size_t end) {
+                        value_type u = shift.pow(begin);
+                        for (std::size_t i = begin; i < end; ++i) {
+                            value_type value = coefficients[i] * u;
+                            value_type power = u;
+                            for (std::size_t k = i + size; k < coefficients.size(); k += size) {
+                                power *= shift_to_size;
+                                value += coefficients[k] * power;
+                            }
+                            values[i] = value;
+                            u *= shift;
+                        }
+                    }, ThreadPool::PoolLevel::HIGH);
+                math::fft(domain, values);
+            }
         }    // namespace fft
     }        // namespace crypto3
 }    // namespace nil
@@ -53,24 +53,31 @@ namespace nil {
             class basic_radix2_domain : public evaluation_domain<FieldType, ValueType> {
                 typedef typename FieldType::value_type field_value_type;
                 typedef ValueType value_type;
-                typedef std::pair<std::vector<field_value_type>, std::vector<field_value_type>> cache_type;
-                std::shared_ptr<cache_type> fft_cache;
+                typedef typename detail::fft_twiddle_cache<FieldType>::tables_type cache_type;
+                std::shared_ptr<const cache_type> fft_cache;
 
                 void create_fft_cache() {
-                    fft_cache = std::make_shared<cache_type>(std::vector<field_value_type>(),
-                                                             std::vector<field_value_type>());
-                    detail::create_fft_cache<FieldType>(this->m, omega, fft_cache->first);
-                    detail::create_fft_cache<FieldType>(this->m, omega.inversed(), fft_cache->second);
+                    fft_cache = detail::fft_twiddle_cache<FieldType>::instance().get(this->m);
                 }
 
             public:
                 typedef FieldType field_type;
 
+                enum class fft_algorithm {
+                    // One pass over the array per stage, see detail::basic_radix2_fft_cached.
+                    radix2,
+                    // Stages grouped into cache-sized blocks, see detail::blocked_radix2_fft_cached.
+                    cache_blocked
+                };
+
                 field_value_type omega;
 
-                basic_radix2_domain(const std::size_t m)
+                // The algorithm is fixed for the life of the domain, the domains of evaluation_domain_cache are
+                // shared by all their holders.
+                basic_radix2_domain(const std::size_t m, fft_algorithm algorithm = fft_algorithm::cache_blocked)
                         : evaluation_domain<FieldType, ValueType>(m),
-                          omega(unity_root<FieldType>(m)) {
+                          omega(unity_root<FieldType>(m)),
+                          algorithm(algorithm) {
                     if (m <= 1)
                         throw std::invalid_argument("basic_radix2(): expected m > 1");
 
@@ -86,6 +93,16 @@ namespace nil {
                 }
 
                 void fft(std::vector<value_type> &a) override {
+                    this->fft<std::allocator<value_type>>(a);
+                }
+
+                void inverse_fft(std::vector<value_type> &a) override {
+                    this->inverse_fft<std::allocator<value_type>>(a);
+                }
+
+                // Same as the virtual fft and inverse_fft, for the vectors with any allocator, see math::fft.
+                template<typename Allocator>
+                void fft(std::vector<value_type, Allocator> &a) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type::zero());
@@ -94,10 +111,11 @@ namespace nil {
                         }
                     }
 
-                    detail::basic_radix2_fft_cached<FieldType>(a, fft_cache->first);
+                    run_fft(a, fft_cache->first);
                 }
 
-                void inverse_fft(std::vector<value_type> &a) override {
+                template<typename Allocator>
+                void inverse_fft(std::vector<value_type, Allocator> &a) {
                     if (a.size() != this->m) {
                         if (a.size() < this->m) {
                             a.resize(this->m, value_type::zero());
@@ -106,7 +124,7 @@ namespace nil {
                         }
                     }
 
-                    detail::basic_radix2_fft_cached<FieldType>(a, fft_cache->second);
+                    run_fft(a, fft_cache->second);
 
                     const field_value_type sconst = field_value_type(a.size()).inversed();
                     nil::crypto3::parallel_foreach(a.begin(), a.end(), [&sconst](value_type& a_i){
@@ -114,6 +132,28 @@ namespace nil {
                     });
                 }
 
+                void fft_batch(std::vector<std::vector<value_type>> &columns) override {
+                    for_each_column(columns, [this](std::vector<value_type> &a, bool serial) {
+                        run_fft(a, fft_cache->first, serial);
+                    });
+                }
+
+                void inverse_fft_batch(std::vector<std::vector<value_type>> &columns) override {
+                    const field_value_type sconst = field_value_type(this->m).inversed();
+                    for_each_column(columns, [this, &sconst](std::vector<value_type> &a, bool serial) {
+                        run_fft(a, fft_cache->second, serial);
+                        if (serial) {
+                            for (auto &a_i : a) {
+                                a_i *= sconst;
+                            }
+                        } else {
+                            nil::crypto3::parallel_foreach(a.begin(), a.end(), [&sconst](value_type& a_i){
+                                a_i *= sconst;
+                            });
+                        }
+                    });
+                }
+
                 std::vector<field_value_type> evaluate_all_lagrange_polynomials(const field_value_type &t) override {
                     return detail::basic_radix2_evaluate_all_lagrange_polynomials<FieldType>(this->m, t);
                 }
@@ -130,6 +170,10 @@ namespace nil {
                     return tmp;
                 }
 
+                fft_algorithm get_fft_algorithm() const {
+                    return algorithm;
+                }
+
                 const field_value_type &get_unity_root() override {
                     return omega;
                 }
@@ -170,6 +214,47 @@ namespace nil {
                 bool operator!=(const basic_radix2_domain &rhs) const {
                     return !(*this == rhs);
                 }
+
+            private:
+                const fft_algorithm algorithm;
+
+                template<typename Range>
+                void run_fft(Range &a, const std::vector<field_value_type> &omega_cache, bool serial = false) const {
+                    if (serial) {
+                        detail::serial_radix2_fft_cached<FieldType>(a, omega_cache);
+                    } else if (get_fft_algorithm() == fft_algorithm::cache_blocked) {
+                        detail::blocked_radix2_fft_cached<FieldType>(a, omega_cache);
+                    } else {
+                        detail::basic_radix2_fft_cached<FieldType>(a, omega_cache);
+                    }
+                }
+
+                /*
+                 * Pads the columns to the size of the domain and calls func(column, serial) for each of them.
+                 * A column that fits in a block of the cache-blocked FFT is transformed by a single task, serially,
+                 * the columns are spread over the workers. Larger columns are transformed one after another, each
+                 * of them in parallel.
+                 */
+                template<typename ColumnFunc>
+                void for_each_column(std::vector<std::vector<value_type>> &columns, ColumnFunc func) const {
+                    for (const auto &a : columns) {
+                        if (a.size() > this->m)
+                            throw std::invalid_argument("basic_radix2: expected a.size() <= this->m");
+                    }
+
+                    const std::size_t block_log = detail::fft_elements_log(detail::FFT_BLOCK_BYTES, sizeof(value_type));
+                    if (this->log2_size <= block_log) {
+                        parallel_for(0, columns.size(), [this, &columns, &func](std::size_t i) {
+                            columns[i].resize(this->m, value_type::zero());
+                            func(columns[i], true);
+                        }, ThreadPool::PoolLevel::HIGH);
+                    } else {
+                        for (auto &a : columns) {
+                            a.resize(this->m, value_type::zero());
+                            func(a, false);
+                        }
+                    }
+                }
             };
         }    // namespace math
     }        // namespace crypto3
@@ -32,11 +32,14 @@
 #endif
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <nil/crypto3/algebra/type_traits.hpp>
 
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
 #include <nil/crypto3/math/detail/field_utils.hpp>
 
@@ -58,14 +61,86 @@ namespace nil {
                         std::vector<typename FieldType::value_type> &cache) {
                     typedef typename FieldType::value_type value_type;
                     cache.resize(size, FieldType::value_type::zero());
-                    wait_for_all(parallel_run_in_chunks<void>(
+                    parallel_for_chunks(
                         size,
                         [&cache, &omega](std::size_t begin, std::size_t end) {
                             cache[begin] = omega.pow(begin);
                             for (std::size_t i = begin + 1; i < end; ++i) {
                                 cache[i] = cache[i - 1] * omega;
                             }
-                        }, ThreadPool::PoolLevel::LOW));
+                        }, ThreadPool::PoolLevel::LOW);
+                }
+
+                /**
+                 * Process-wide cache of the FFT twiddle tables of FieldType: for each size n, the powers of
+                 * unity_root<FieldType>(n) and of its inverse, as built by create_fft_cache. The tables are never
+                 * modified once built, so the domains and FFTs of the same size share them between threads.
+                 */
+                template<typename FieldType>
+                class fft_twiddle_cache {
+                public:
+                    typedef typename FieldType::value_type value_type;
+                    // Forward and inverse twiddles.
+                    typedef std::pair<std::vector<value_type>, std::vector<value_type>> tables_type;
+
+                    static fft_twiddle_cache &instance() {
+                        static fft_twiddle_cache cache;
+                        return cache;
+                    }
+
+                    std::shared_ptr<const tables_type> get(std::size_t size) {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            auto it = tables.find(size);
+                            if (it != tables.end())
+                                return it->second;
+                        }
+
+                        // Built without holding the lock, create_fft_cache runs on the thread pool.
+                        auto result = std::make_shared<tables_type>();
+                        const value_type omega = unity_root<FieldType>(size);
+                        create_fft_cache<FieldType>(size, omega, result->first);
+                        create_fft_cache<FieldType>(size, omega.inversed(), result->second);
+
+                        // If another thread has built the same tables meanwhile, its tables are kept.
+                        std::lock_guard<std::mutex> lock(mutex);
+                        return tables.emplace(size, std::move(result)).first->second;
+                    }
+
+                    // Returns the size of the cached tables in bytes.
+                    std::size_t memory_usage() const {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::size_t result = 0;
+                        for (const auto &[size, table] : tables) {
+                            result += (table->first.capacity() + table->second.capacity()) * sizeof(value_type);
+                        }
+                        return result;
+                    }
+
+                    // The tables already handed out stay alive as long as they are used.
+                    void clear() {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        tables.clear();
+                    }
+
+                private:
+                    fft_twiddle_cache() = default;
+
+                    mutable std::mutex mutex;
+                    std::map<std::size_t, std::shared_ptr<const tables_type>> tables;
+                };
+
+                // swapping in place (from Storer's book)
+                template<typename Range>
+                void bitreverse_permutation(Range &a, std::size_t logn) {
+                    // We can parallelize this look, since k and rk are pairs, they will never intersect.
+                    nil::crypto3::parallel_for(0, a.size(),
+                        [logn, &a](std::size_t k) {
+                            const std::size_t rk = crypto3::math::detail::bitreverse(k, logn);
+                            if (k < rk)
+                                std::swap(a[k], a[rk]);
+                        }
+                    );
                 }
 
                 /*
@@ -85,15 +160,7 @@ namespace nil {
                     if (n != (1u << logn))
                         throw std::invalid_argument("expected n == (1u << logn)");
 
-                    // swapping in place (from Storer's book)
-                    // We can parallelize this look, since k and rk are pairs, they will never intersect.
-                    nil::crypto3::parallel_for(0, n,
-                        [logn, &a](std::size_t k) {
-                            const std::size_t rk = crypto3::math::detail::bitreverse(k, logn);
-                            if (k < rk)
-                                std::swap(a[k], a[rk]);
-                        }
-                    );
+                    bitreverse_permutation(a, logn);
 
 
                     // invariant: m = 2^{s-1}
@@ -104,7 +171,7 @@ namespace nil {
 
                         // Here we can parallelize on the both loops with 'k' and 'm', because for each value of k and m
                         // the ranges of array 'a' used do not intersect. Think of these 2 loops as 1.
-                        wait_for_all(parallel_run_in_chunks<void>(
+                        parallel_for_chunks(
                             m * count_k,
                             [&a, m, count_k, inc, &omega_cache](std::size_t begin, std::size_t end) {
                                 size_t current_index = begin;
@@ -129,7 +196,168 @@ namespace nil {
                                     }
                                 }
                             }, ThreadPool::PoolLevel::LOW
-                        ));
+                        );
+                    }
+                }
+
+                // The blocks of blocked_radix2_fft_cached take about half of a typical L2 cache.
+                static constexpr std::size_t FFT_BLOCK_BYTES = 1 << 18;
+                // The stages over the blocks work on groups of neighbouring columns, about 2 cache lines of each row.
+                static constexpr std::size_t FFT_GROUP_BYTES = 1 << 7;
+
+                // Largest power of two not greater than 'bytes' / 'element_size', at least 1.
+                inline std::size_t fft_elements_log(std::size_t bytes, std::size_t element_size) {
+                    std::size_t result = 0;
+                    while ((element_size << (result + 1)) <= bytes) {
+                        ++result;
+                    }
+                    return result;
+                }
+
+                /*
+                 * Cache-blocked version of basic_radix2_fft_cached, takes the same input and the same cache.
+                 *
+                 * The array is viewed as a matrix of 'blocks_count' rows of 'block_size' elements. After the bit reversal
+                 * the first log(block_size) stages only mix elements of the same row, so they are done row by row while
+                 * the row is in L2. The remaining stages only mix elements of the same column, they are done for a group
+                 * of neighbouring columns at a time, copied to a local buffer. Rows and groups are independent, so there
+                 * is no barrier between the stages, and the array goes through the memory 3 times instead of log(n) + 1.
+                 *
+                 * The bit reversal could be merged into the row pass only if the columns were transposed at the end,
+                 * which in place costs as much as the bit reversal itself, so it stays a separate pass.
+                 * Note that it's the caller's responsibility to multiply by 1/N.
+                 */
+                template<typename FieldType, typename Range>
+                void blocked_radix2_fft_cached(Range &a, const std::vector<typename FieldType::value_type> &omega_cache) {
+                    typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                        value_type;
+                    typedef typename FieldType::value_type field_value_type;
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+
+                    const std::size_t n = a.size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+
+                    const std::size_t block_log = fft_elements_log(FFT_BLOCK_BYTES, sizeof(value_type));
+                    if (logn <= block_log) {
+                        // Everything fits in one block anyway.
+                        basic_radix2_fft_cached<FieldType>(a, omega_cache);
+                        return;
+                    }
+                    const std::size_t block_size = std::size_t(1) << block_log;
+                    const std::size_t blocks_count = n >> block_log;
+                    const std::size_t group_size = std::size_t(1) << std::min(
+                        block_log, fft_elements_log(FFT_GROUP_BYTES, sizeof(value_type)));
+
+                    bitreverse_permutation(a, logn);
+
+                    // Twiddles of the stages inside a row, stage 'm' uses low_twiddles[m, 2m). In omega_cache they
+                    // are 'n / 2m' apart.
+                    std::vector<field_value_type> low_twiddles(block_size);
+                    for (std::size_t m = 1; m < block_size; m <<= 1) {
+                        for (std::size_t j = 0; j < m; ++j) {
+                            low_twiddles[m + j] = omega_cache[j * (n / (2 * m))];
+                        }
+                    }
+
+                    // A row or a group is a whole block of work, there are only a few hundreds of them, so they are
+                    // split with the smallest chunk size rather than the one for the cheap loops.
+                    parallel_for_chunks(
+                        blocks_count,
+                        [&a, &low_twiddles, block_size](std::size_t begin, std::size_t end) {
+                            value_type t;
+                            for (std::size_t row = begin; row < end; ++row) {
+                                const std::size_t row_begin = row * block_size;
+                                for (std::size_t m = 1; m < block_size; m <<= 1) {
+                                    for (std::size_t k = row_begin; k < row_begin + block_size; k += 2 * m) {
+                                        for (std::size_t j = 0; j < m; ++j) {
+                                            t = a[k + j + m];
+                                            t *= low_twiddles[m + j];
+                                            a[k + j + m] = a[k + j];
+                                            a[k + j + m] -= t;
+                                            a[k + j] += t;
+                                        }
+                                    }
+                                }
+                            }
+                        }, ThreadPool::PoolLevel::LOW, 1);
+
+                    parallel_for_chunks(
+                        block_size / group_size,
+                        [&a, &omega_cache, n, block_size, blocks_count, group_size](std::size_t begin, std::size_t end) {
+                            // local[row * group_size + column] is a[row * block_size + first_column + column].
+                            std::vector<value_type> local(blocks_count * group_size);
+                            value_type t;
+                            for (std::size_t group = begin; group < end; ++group) {
+                                const std::size_t first_column = group * group_size;
+                                for (std::size_t row = 0; row < blocks_count; ++row) {
+                                    for (std::size_t column = 0; column < group_size; ++column) {
+                                        local[row * group_size + column] = a[row * block_size + first_column + column];
+                                    }
+                                }
+
+                                // Stage 'm = rows * block_size' mixes rows 'rows' apart. The twiddle of a pair does not
+                                // depend on 'k', so it is read once per stage.
+                                for (std::size_t rows = 1; rows < blocks_count; rows <<= 1) {
+                                    const std::size_t inc = blocks_count / (2 * rows);
+                                    for (std::size_t j = 0; j < rows; ++j) {
+                                        for (std::size_t column = 0; column < group_size; ++column) {
+                                            const field_value_type &omega =
+                                                omega_cache[(j * block_size + first_column + column) * inc];
+                                            for (std::size_t k = 0; k < blocks_count; k += 2 * rows) {
+                                                const std::size_t top = (k + j) * group_size + column;
+                                                const std::size_t bottom = top + rows * group_size;
+                                                t = local[bottom];
+                                                t *= omega;
+                                                local[bottom] = local[top];
+                                                local[bottom] -= t;
+                                                local[top] += t;
+                                            }
+                                        }
+                                    }
+                                }
+
+                                for (std::size_t row = 0; row < blocks_count; ++row) {
+                                    for (std::size_t column = 0; column < group_size; ++column) {
+                                        a[row * block_size + first_column + column] = local[row * group_size + column];
+                                    }
+                                }
+                            }
+                        }, ThreadPool::PoolLevel::LOW, 1);
+                }
+
+                /*
+                 * Single-threaded version of basic_radix2_fft_cached, for the columns of a batch that are transformed
+                 * by one task each. Splitting a column that small into chunks costs more than it saves.
+                 * Note that it's the caller's responsibility to multiply by 1/N.
+                 */
+                template<typename FieldType, typename Range>
+                void serial_radix2_fft_cached(Range &a, const std::vector<typename FieldType::value_type> &omega_cache) {
+                    typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
+                        value_type;
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+
+                    const std::size_t n = a.size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const std::size_t rk = crypto3::math::detail::bitreverse(k, logn);
+                        if (k < rk)
+                            std::swap(a[k], a[rk]);
+                    }
+
+                    value_type t;
+                    for (std::size_t m = 1, inc = n / 2; m < n; m <<= 1, inc >>= 1) {
+                        for (std::size_t k = 0; k < n; k += 2 * m) {
+                            for (std::size_t j = 0, idx = 0; j < m; ++j, idx += inc) {
+                                t = a[k + j + m];
+                                t *= omega_cache[idx];
+                                a[k + j + m] = a[k + j];
+                                a[k + j + m] -= t;
+                                a[k + j] += t;
+                            }
+                        }
                     }
                 }
 
@@ -142,11 +370,19 @@ namespace nil {
                     std::shared_ptr<std::vector<typename FieldType::value_type>> omega_cache = nullptr) {
 
                     if (omega_cache == nullptr) {
-                        std::vector<typename FieldType::value_type> omega_powers;
-                        create_fft_cache<FieldType>(a.size(), omega, omega_powers);
-                        basic_radix2_fft_cached<FieldType>(a, omega_powers);
+                        // The callers almost always pass the unity root of the size or its inverse, whose powers
+                        // are cached.
+                        const typename FieldType::value_type root = unity_root<FieldType>(a.size());
+                        if (omega == root || omega == root.inversed()) {
+                            auto tables = fft_twiddle_cache<FieldType>::instance().get(a.size());
+                            blocked_radix2_fft_cached<FieldType>(a, omega == root ? tables->first : tables->second);
+                        } else {
+                            std::vector<typename FieldType::value_type> omega_powers;
+                            create_fft_cache<FieldType>(a.size(), omega, omega_powers);
+                            blocked_radix2_fft_cached<FieldType>(a, omega_powers);
+                        }
                     } else {
-                        basic_radix2_fft_cached<FieldType>(a, *omega_cache);
+                        blocked_radix2_fft_cached<FieldType>(a, *omega_cache);
                     }
                 }
 
@@ -199,13 +435,24 @@ namespace nil {
                      */
 
                     const value_type Z = (t.pow(m)) - value_type::one();
-                    value_type l = Z * value_type(m).inversed();
-                    value_type r = value_type::one();
-                    for (std::size_t i = 0; i < m; ++i) {
-                        u[i] = l * (t - r).inversed();
-                        l *= omega;
-                        r *= omega;
-                    }
+                    const value_type l = Z * value_type(m).inversed();
+                    parallel_for_chunks(m,
+                        [&u, &t, &omega](std::size_t begin, std::size_t end) {
+                            value_type r = omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                u[i] = t - r;
+                                r *= omega;
+                            }
+                        });
+                    batch_inversion(u);
+                    parallel_for_chunks(m,
+                        [&u, &l, &omega](std::size_t begin, std::size_t end) {
+                            value_type l_i = l * omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                u[i] *= l_i;
+                                l_i *= omega;
+                            }
+                        });
 
                     return u;
                 }
@@ -89,6 +89,25 @@ namespace nil {
                  */
                 virtual void inverse_fft(std::vector<value_type> &a) = 0;
 
+                /**
+                 * Compute the FFT, over the domain S, of each of the vectors in 'columns'. Domains that can share
+                 * the work between the columns override this.
+                 */
+                virtual void fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    for (auto &column : columns) {
+                        fft(column);
+                    }
+                }
+
+                /**
+                 * Compute the inverse FFT, over the domain S, of each of the vectors in 'columns'.
+                 */
+                virtual void inverse_fft_batch(std::vector<std::vector<value_type>> &columns) {
+                    for (auto &column : columns) {
+                        inverse_fft(column);
+                    }
+                }
+
                 /**
                  * Evaluate all Lagrange polynomials.
                  *
@@ -51,15 +51,12 @@ namespace nil {
             class extended_radix2_domain : public evaluation_domain<FieldType, ValueType> {
                 typedef typename FieldType::value_type field_value_type;
                 typedef ValueType value_type;
-                typedef std::pair<std::vector<field_value_type>, std::vector<field_value_type>> cache_type;
+                typedef typename detail::fft_twiddle_cache<FieldType>::tables_type cache_type;
 
-                std::unique_ptr<cache_type> fft_cache;
+                std::shared_ptr<const cache_type> fft_cache;
 
                 void create_fft_cache() {
-                    fft_cache = std::make_unique<cache_type>(std::vector<field_value_type>(),
-                                                             std::vector<field_value_type>());
-                    detail::create_fft_cache<FieldType>(small_m, omega, fft_cache->first);
-                    detail::create_fft_cache<FieldType>(small_m, omega.inversed(), fft_cache->second);
+                    fft_cache = detail::fft_twiddle_cache<FieldType>::instance().get(small_m);
                 }
             public:
                 typedef FieldType field_type;
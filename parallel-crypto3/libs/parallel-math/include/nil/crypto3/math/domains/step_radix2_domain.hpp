@@ -51,19 +51,14 @@ namespace nil {
             class step_radix2_domain : public evaluation_domain<FieldType, ValueType> {
                 typedef typename FieldType::value_type field_value_type;
                 typedef ValueType value_type;
-                typedef std::pair<std::vector<field_value_type>, std::vector<field_value_type>> cache_type;
+                typedef typename detail::fft_twiddle_cache<FieldType>::tables_type cache_type;
 
-                std::unique_ptr<cache_type> small_fft_cache, big_fft_cache;
+                std::shared_ptr<const cache_type> small_fft_cache, big_fft_cache;
 
                 void create_fft_cache() {
-                    small_fft_cache = std::make_unique<cache_type>(
-                        std::make_pair(std::vector<field_value_type>(), std::vector<field_value_type>()));
-                    big_fft_cache = std::make_unique<cache_type>(
-                        std::make_pair(std::vector<field_value_type>(), std::vector<field_value_type>()));
-                    detail::create_fft_cache<FieldType>(big_m, big_omega, big_fft_cache->first);
-                    detail::create_fft_cache<FieldType>(big_m, big_omega.inversed(), big_fft_cache->second);
-                    detail::create_fft_cache<FieldType>(small_m, small_omega, small_fft_cache->first);
-                    detail::create_fft_cache<FieldType>(small_m, small_omega.inversed(), small_fft_cache->second);
+                    // big_omega and small_omega are the unity roots of their sizes.
+                    big_fft_cache = detail::fft_twiddle_cache<FieldType>::instance().get(big_m);
+                    small_fft_cache = detail::fft_twiddle_cache<FieldType>::instance().get(small_m);
                 }
             public:
                 typedef FieldType field_type;
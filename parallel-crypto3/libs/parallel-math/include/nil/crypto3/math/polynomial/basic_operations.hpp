@@ -311,6 +311,113 @@ namespace nil {
                 return result;
             }
 
+            namespace detail {
+                // Below this degree of the divisor or of the quotient the long division is faster than the
+                // Newton iteration.
+                constexpr std::size_t FAST_DIVISION_THRESHOLD = 64;
+            }    // namespace detail
+
+            /**
+             * Divides polynomial A by (X - point) with synthetic division (Ruffini's rule).
+             * Output: Polynomial Q, such that A = Q * (X - point) + remainder, and remainder = A(point).
+             */
+            template<typename Range, typename ValueType>
+            Range division_by_linear(const Range &a, const ValueType &point, ValueType &remainder) {
+                std::size_t n = std::distance(std::begin(a), std::end(a));
+
+                if (n < 2) {
+                    remainder = n == 0 ? ValueType::zero() : a[0];
+                    return Range(1, ValueType::zero());
+                }
+
+                Range q(n - 1, ValueType::zero());
+                ValueType acc = a[n - 1];
+                for (std::size_t i = n - 1; i > 0; --i) {
+                    q[i - 1] = acc;
+                    acc = a[i - 1] + acc * point;
+                }
+                remainder = acc;
+                condense(q);
+                return q;
+            }
+
+            /**
+             * Computes the inverse of polynomial A modulo X^n with Newton iteration, A[0] must be non-zero.
+             * Each step doubles the precision: G' = G * (2 - A * G) mod X^{2m}.
+             */
+            template<typename Range>
+            Range reciprocal(const Range &a, std::size_t n) {
+                typedef
+                typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                std::size_t a_size = std::distance(std::begin(a), std::end(a));
+
+                Range g(1, a[0].inversed());
+                for (std::size_t m = 1; m < n;) {
+                    m = std::min(2 * m, n);
+
+                    Range a_m(std::min(m, a_size), value_type::zero());
+                    std::copy(std::begin(a), std::begin(a) + a_m.size(), std::begin(a_m));
+
+                    // E = A * G - 1 mod X^m, its lower half is zero.
+                    Range e;
+                    multiplication(e, a_m, g);
+                    e.resize(m, value_type::zero());
+                    e[0] -= value_type::one();
+
+                    Range t;
+                    multiplication(t, g, e);
+                    t.resize(m, value_type::zero());
+
+                    g.resize(m, value_type::zero());
+                    nil::crypto3::parallel_transform(
+                        std::begin(g), std::end(g), std::begin(t), std::begin(g), std::minus<value_type>());
+                }
+                g.resize(n, value_type::zero());
+                return g;
+            }
+
+            /**
+             * Divides polynomial A by polynomial B using the reversed reciprocal of B and FFT multiplications,
+             * requires A.size() >= B.size().
+             * Output: Polynomial Q, Polynomial R, such that A = (Q * B) + R.
+             */
+            template<typename Range>
+            void fast_division(Range &q, Range &r, const Range &a, const Range &b) {
+                typedef
+                typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type value_type;
+
+                std::size_t n = a.size();
+                std::size_t d = b.size() - 1;
+                std::size_t k = n - d; /* Size of Q */
+
+                // rev(A) = rev(Q) * rev(B) mod X^k.
+                Range rev_a(k, value_type::zero());
+                std::reverse_copy(a.end() - k, a.end(), rev_a.begin());
+                Range rev_b(std::min(k, d + 1), value_type::zero());
+                std::reverse_copy(b.end() - rev_b.size(), b.end(), rev_b.begin());
+
+                Range rev_q;
+                multiplication(rev_q, rev_a, reciprocal(rev_b, k));
+                rev_q.resize(k, value_type::zero());
+
+                Range new_q(k, value_type::zero());
+                std::reverse_copy(rev_q.begin(), rev_q.end(), new_q.begin());
+                condense(new_q);
+
+                Range qb;
+                multiplication(qb, new_q, b);
+                qb.resize(d, value_type::zero());
+
+                Range new_r(d, value_type::zero());
+                nil::crypto3::parallel_transform(
+                    a.begin(), a.begin() + d, qb.begin(), new_r.begin(), std::minus<value_type>());
+                condense(new_r);
+
+                q = std::move(new_q);
+                r = std::move(new_r);
+            }
+
             /**
              * Perform the standard Euclidean Division algorithm. We can not assume that q or r are empty.
              * Input: Polynomial A, Polynomial B, where A / B
@@ -349,29 +456,30 @@ namespace nil {
                         }
                     }
                     condense(r);
+                }
+                    // Large divisor and quotient, use Newton iteration.
+                else if (a.size() >= b.size() && d >= detail::FAST_DIVISION_THRESHOLD &&
+                         a.size() - d >= detail::FAST_DIVISION_THRESHOLD) {
+                    fast_division(q, r, a, b);
                 } else {
+                    // Long division, for B = X - z this is the synthetic division.
                     value_type c = b.back().inversed(); /* Inverse of Leading Coefficient of B */
                     r = Range(a);
-                    q = Range(r.size(), value_type::zero());
-
-                    std::size_t r_deg = r.size() - 1;
-                    std::size_t shift;
-
-                    while (r_deg >= d && !is_zero(r)) {
-                        shift = r_deg - d;
-
-                        value_type lead_coeff = r.back() * c;
-
-                        q[shift] = lead_coeff;
-
-                        if (b.size() + shift + 1 > r.size())
-                            r.resize(b.size() + shift + 1);
-                        auto glambda = [=](value_type x, value_type y) { return y - (x * lead_coeff); };
-                        nil::crypto3::parallel_transform(b.begin(), b.end(), r.begin() + shift, r.begin() + shift, glambda);
-
-                        condense(r);
-                        r_deg = r.size() - 1;
+                    q = Range(std::max(a.size(), b.size()) - d, value_type::zero());
+
+                    for (std::size_t i = r.size(); i > d; --i) {
+                        value_type lead_coeff = r[i - 1] * c;
+                        q[i - 1 - d] = lead_coeff;
+                        if (lead_coeff == value_type::zero())
+                            continue;
+                        for (std::size_t j = 0; j < d; ++j) {
+                            r[i - 1 - d + j] -= b[j] * lead_coeff;
+                        }
+                    }
+                    if (r.size() > d) {
+                        r.resize(d);
                     }
+                    condense(r);
                 }
                 condense(q);
             }
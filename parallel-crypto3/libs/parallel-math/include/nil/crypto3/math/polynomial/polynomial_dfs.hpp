@@ -33,13 +33,18 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
 #include <vector>
 #include <ostream>
 #include <iterator>
+#include <stdexcept>
 #include <unordered_map>
 
+#include <nil/crypto3/math/algorithms/fft.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
@@ -144,7 +149,7 @@ namespace nil {
                                      "DFS optimal polynomial size must be a power of two");
                 }
 
-                polynomial_dfs(size_t d, container_type&& c) : val(c), _d(d) {
+                polynomial_dfs(size_t d, container_type&& c) : val(std::move(c)), _d(d) {
                     BOOST_ASSERT_MSG(val.size() == detail::power_of_two(val.size()),
                                      "DFS optimal polynomial size must be a power of two");
                 }
@@ -354,18 +359,23 @@ namespace nil {
                     } else {
                         typedef typename value_type::field_type FieldType;
                         if (old_domain == nullptr) {
-                            old_domain = make_evaluation_domain<FieldType>(this->size());
+                            old_domain = get_evaluation_domain<FieldType>(this->size());
                         } else {
                             BOOST_ASSERT_MSG(old_domain->size() == this->size(), "Old domain size is not equal to the polynomial size");
                         }
-                        old_domain->inverse_fft(this->val);
-                        this->val.resize(_sz, FieldValueType::zero());
-                        if (new_domain == nullptr) {
-                            new_domain = make_evaluation_domain<FieldType>(_sz);
-                        } else {
+                        if (new_domain != nullptr) {
                             BOOST_ASSERT_MSG(new_domain->size() == _sz, "New domain size is not equal to the polynomial size");
                         }
-                        new_domain->fft(this->val);
+                        inverse_fft(old_domain);
+                        if (_sz > this->size()) {
+                            extend_on_cosets(_sz, old_domain, new_domain);
+                        } else {
+                            this->val.resize(_sz, FieldValueType::zero());
+                            if (new_domain == nullptr) {
+                                new_domain = get_evaluation_domain<FieldType>(_sz);
+                            }
+                            fft(new_domain);
+                        }
                     }
                 }
 
@@ -374,11 +384,23 @@ namespace nil {
                     std::swap(_d, other._d);
                 }
 
+                /**
+                 * Evaluates the polynomial at 'value'. On a radix-2 domain the barycentric formula is used,
+                 * which is O(n) with a single field inversion per chunk instead of an inverse FFT.
+                 */
                 FieldValueType evaluate(const FieldValueType& value) const {
+                    typedef typename value_type::field_type FieldType;
+                    // A polynomial of degree 0 has the same value everywhere.
+                    if (this->size() == 1 || this->_d == 0) {
+                        return val[0];
+                    }
+                    if (detail::is_basic_radix2_domain<FieldType>(this->size())) {
+                        return evaluate_barycentric(value);
+                    }
+
                     std::vector<FieldValueType> tmp = this->coefficients();
                     FieldValueType result = FieldValueType::zero();
                     auto end = tmp.end();
-                    // TODO(martun): parallelize the lower loop.
                     while (end != tmp.begin()) {
                         result = result * value + *--end;
                     }
@@ -586,6 +608,29 @@ namespace nil {
                     return *this;
                 }
 
+                /**
+                 * Calls func(A[i], B[i], C[i], ...) for every point i, in a single parallel pass over polynomial A
+                 * and the 'others', and sets the degree of A to 'new_degree'. A chain of pointwise operations like
+                 * A = A * beta + gamma + B written with the operators makes a pass over the vectors and often
+                 * a temporary for each operation, here it makes one pass and none.
+                 * The 'others' can be any polynomial_dfs or view of the same size as A, std::invalid_argument is
+                 * thrown otherwise.
+                 */
+                template<typename Func, typename... Polynomials>
+                polynomial_dfs& fused_apply(size_type new_degree, Func func, const Polynomials&... others) {
+                    if (!((others.size() == this->size()) && ...)) {
+                        throw std::invalid_argument("fused_apply: expected polynomials of the same size");
+                    }
+                    this->_d = new_degree;
+                    parallel_for_chunks(this->size(),
+                        [this, &func, &others...](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                func(this->val[i], others[i]...);
+                            }
+                        }, ThreadPool::PoolLevel::LOW);
+                    return *this;
+                }
+
                 /**
                  * Perform the standard Euclidean Division algorithm.
                  * Input: Polynomial A, Polynomial B, where A / B
@@ -679,6 +724,92 @@ namespace nil {
                     return result;
                 }
 
+            private:
+                // f(z) = (z^n - 1) / n * sum_i val[i] * omega^i / (z - omega^i). Each chunk adds up its terms as
+                // one fraction, so it needs one inversion at the end instead of one per element.
+                FieldValueType evaluate_barycentric(const FieldValueType& value) const {
+                    typedef typename value_type::field_type FieldType;
+                    const std::size_t n = this->size();
+                    const FieldValueType omega = unity_root<FieldType>(n);
+
+                    const FieldValueType vanishing = value.pow(n) - FieldValueType::one();
+                    if (vanishing == FieldValueType::zero()) {
+                        // 'value' is a point of the domain.
+                        FieldValueType omega_i = FieldValueType::one();
+                        for (std::size_t i = 0; i < n; ++i) {
+                            if (omega_i == value) {
+                                return val[i];
+                            }
+                            omega_i *= omega;
+                        }
+                    }
+
+                    FieldValueType sum = parallel_reduce(n, FieldValueType::zero(),
+                        [this, &value, &omega](std::size_t begin, std::size_t end) {
+                            FieldValueType numerator = FieldValueType::zero();
+                            FieldValueType denominator = FieldValueType::one();
+                            FieldValueType omega_i = omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                const FieldValueType d = value - omega_i;
+                                numerator = numerator * d + this->val[i] * omega_i * denominator;
+                                denominator *= d;
+                                omega_i *= omega;
+                            }
+                            return numerator * denominator.inversed();
+                        },
+                        [](FieldValueType a, FieldValueType b) { return a + b; });
+                    return sum * vanishing * FieldValueType(n).inversed();
+                }
+
+                // Replaces the coefficients in 'val' with the values on the domain of size '_sz', a multiple of the
+                // current size. The large domain is a union of cosets of the current one, see evaluate_on_cosets,
+                // so it is not built unless the caller already has it. The cosets are computed one at a time in a
+                // buffer of the current size and written to their places in 'val', so besides 'val' itself only
+                // the coefficients and that buffer are held.
+                void extend_on_cosets(size_type _sz,
+                                      std::shared_ptr<evaluation_domain<typename value_type::field_type>> old_domain,
+                                      std::shared_ptr<evaluation_domain<typename value_type::field_type>> new_domain) {
+                    typedef typename value_type::field_type FieldType;
+                    const std::size_t size = this->size();
+                    const std::size_t blowup = _sz / size;
+
+                    const FieldValueType extended_omega = (new_domain == nullptr)
+                        ? unity_root<FieldType>(_sz) : new_domain->get_domain_element(1);
+                    BOOST_ASSERT_MSG(extended_omega.pow(blowup) == old_domain->get_domain_element(1),
+                                     "The old domain is not a subgroup of the new one");
+
+                    std::vector<FieldValueType> coefficients;
+                    if constexpr (std::is_same<container_type, std::vector<FieldValueType>>::value) {
+                        coefficients.swap(this->val);
+                    } else {
+                        coefficients.assign(this->val.begin(), this->val.end());
+                        this->val.clear();
+                        this->val.shrink_to_fit();
+                    }
+                    this->val.resize(_sz);
+
+                    std::vector<FieldValueType> coset;
+                    FieldValueType shift = FieldValueType::one();
+                    for (std::size_t r = 0; r < blowup; ++r) {
+                        evaluate_on_coset<FieldType>(coefficients, old_domain, shift, coset);
+                        parallel_for_chunks(size,
+                            [this, &coset, blowup, r](std::size_t begin, std::size_t end) {
+                                for (std::size_t j = begin; j < end; ++j) {
+                                    this->val[j * blowup + r] = coset[j];
+                                }
+                            }, ThreadPool::PoolLevel::LOW);
+                        shift *= extended_omega;
+                    }
+                }
+
+                // Storage with any allocator, see math::fft.
+                void fft(std::shared_ptr<evaluation_domain<typename value_type::field_type>> domain) {
+                    math::fft(domain, this->val);
+                }
+
+                void inverse_fft(std::shared_ptr<evaluation_domain<typename value_type::field_type>> domain) {
+                    math::inverse_fft(domain, this->val);
+                }
             };
 
             template<typename FieldValueType, typename Allocator = std::allocator<FieldValueType>,
@@ -793,6 +924,147 @@ namespace nil {
                 return os;
             }
 
+            /**
+             * Same as calling resize(new_size, nullptr, new_domain) on each polynomial of 'polys', but the polynomials
+             * of the same size are interpolated with one batched inverse FFT and all of them are evaluated on the new
+             * domain with one batched FFT, so the domains and their twiddles are built once, and small polynomials
+             * are transformed in parallel with each other.
+             */
+            template<typename FieldType, typename PolynomialRange>
+            static inline void resize_batch(
+                    PolynomialRange& polys,
+                    std::size_t new_size,
+                    std::shared_ptr<evaluation_domain<FieldType>> new_domain = nullptr) {
+                using container_type = std::vector<typename FieldType::value_type>;
+
+                // Polynomials to resize, grouped by their current size.
+                std::map<std::size_t, std::vector<polynomial_dfs<typename FieldType::value_type>*>> groups;
+                for (auto& poly : polys) {
+                    if (poly.size() == new_size) {
+                        continue;
+                    }
+                    BOOST_ASSERT_MSG(new_size >= poly.degree(), "Resizing DFS polynomial to a size less than degree is prohibited: can't restore the polynomial in the future.");
+                    if (poly.degree() == 0) {
+                        poly.resize(new_size);
+                    } else {
+                        groups[poly.size()].push_back(&poly);
+                    }
+                }
+                if (groups.empty()) {
+                    return;
+                }
+
+                if (new_domain == nullptr) {
+                    new_domain = get_evaluation_domain<FieldType>(new_size);
+                } else {
+                    BOOST_ASSERT_MSG(new_domain->size() == new_size, "New domain size is not equal to the polynomial size");
+                }
+
+                std::vector<container_type> values;
+                for (auto& [old_size, group] : groups) {
+                    std::vector<container_type> group_values(group.size());
+                    for (std::size_t i = 0; i < group.size(); ++i) {
+                        group_values[i].swap(group[i]->get_storage());
+                    }
+                    get_evaluation_domain<FieldType>(old_size)->inverse_fft_batch(group_values);
+                    for (auto& coefficients : group_values) {
+                        // Shrinking is fine, the coefficients above the degree are zeros.
+                        if (coefficients.size() > new_size) {
+                            coefficients.resize(new_size);
+                        }
+                        values.emplace_back(std::move(coefficients));
+                    }
+                }
+
+                new_domain->fft_batch(values);
+
+                std::size_t index = 0;
+                for (auto& [old_size, group] : groups) {
+                    for (auto* poly : group) {
+                        poly->get_storage().swap(values[index++]);
+                    }
+                }
+            }
+
+            /**
+             * The batched FFTs work on std::vector, polynomials with another allocator, such as the ones kept in
+             * memory mapped files, are resized one by one in their own storage.
+             */
+            template<typename FieldType, typename Allocator,
+                     typename std::enable_if<
+                         !std::is_same<Allocator, std::allocator<typename FieldType::value_type>>::value,
+                         bool>::type = true>
+            static inline void resize_batch(
+                    std::vector<polynomial_dfs<typename FieldType::value_type, Allocator>>& polys,
+                    std::size_t new_size,
+                    std::shared_ptr<evaluation_domain<FieldType>> new_domain = nullptr) {
+                for (auto& poly : polys) {
+                    poly.resize(new_size, nullptr, new_domain);
+                }
+            }
+
+            /**
+             * Evaluates each polynomial polys[i] at all the points of points[i], result[i][j] is the value of
+             * polys[i] at points[i][j]. The polynomials on the same radix-2 domain evaluated at the same point share
+             * the Lagrange basis values at that point, so each of them costs a single inner product, and the basis
+             * is computed once per point with one batch inversion. Only one basis is kept in memory at a time.
+             */
+            template<typename FieldValueType, typename Allocator>
+            static inline std::vector<std::vector<FieldValueType>> evaluate_batch(
+                    const std::vector<const polynomial_dfs<FieldValueType, Allocator>*>& polys,
+                    const std::vector<const std::vector<FieldValueType>*>& points) {
+                typedef typename FieldValueType::field_type FieldType;
+                BOOST_ASSERT(polys.size() == points.size());
+
+                std::vector<std::vector<FieldValueType>> result(polys.size());
+                // The pairs (i, j) of the evaluations, grouped by the polynomial size and the point.
+                std::map<std::size_t, std::unordered_map<FieldValueType, std::vector<std::pair<std::size_t, std::size_t>>>>
+                    groups;
+                for (std::size_t i = 0; i < polys.size(); ++i) {
+                    if (polys[i]->degree() == 0) {
+                        // Constant columns need no evaluation.
+                        result[i].assign(points[i]->size(), (*polys[i])[0]);
+                        continue;
+                    }
+                    result[i].resize(points[i]->size());
+                    for (std::size_t j = 0; j < points[i]->size(); ++j) {
+                        groups[polys[i]->size()][(*points[i])[j]].emplace_back(i, j);
+                    }
+                }
+
+                for (const auto& [size, size_groups] : groups) {
+                    for (const auto& [point, evaluations] : size_groups) {
+                        if (evaluations.size() == 1 || !detail::is_basic_radix2_domain<FieldType>(size)) {
+                            // "evaluate" uses the LOW level thread pool.
+                            parallel_for(0, evaluations.size(),
+                                [&polys, &result, &evaluations, &point = point](std::size_t k) {
+                                    auto [i, j] = evaluations[k];
+                                    result[i][j] = polys[i]->evaluate(point);
+                                }, ThreadPool::PoolLevel::HIGH);
+                            continue;
+                        }
+
+                        const std::vector<FieldValueType> lagrange_basis =
+                            detail::basic_radix2_evaluate_all_lagrange_polynomials<FieldType>(size, point);
+                        parallel_for(0, evaluations.size(),
+                            [&polys, &result, &evaluations, &lagrange_basis](std::size_t k) {
+                                auto [i, j] = evaluations[k];
+                                const auto& values = *polys[i];
+                                result[i][j] = parallel_reduce(values.size(), FieldValueType::zero(),
+                                    [&values, &lagrange_basis](std::size_t begin, std::size_t end) {
+                                        FieldValueType sum = FieldValueType::zero();
+                                        for (std::size_t t = begin; t < end; ++t) {
+                                            sum += values[t] * lagrange_basis[t];
+                                        }
+                                        return sum;
+                                    },
+                                    [](FieldValueType a, FieldValueType b) { return a + b; });
+                            }, ThreadPool::PoolLevel::HIGH);
+                    }
+                }
+                return result;
+            }
+
             template<typename FieldType>
             static inline polynomial_dfs<typename FieldType::value_type> polynomial_sum(
                     std::vector<math::polynomial_dfs<typename FieldType::value_type>> addends) {
@@ -839,28 +1111,34 @@ namespace nil {
                 std::vector<polynomial_dfs<FieldValueType>> grouped_addends;
 
                 std::size_t max_size = 0;
-                for (const auto& [size, partial_sum] : size_to_part_sum) {
+                for (auto& [size, partial_sum] : size_to_part_sum) {
                     max_size = std::max(max_size, size);
                     grouped_addends.push_back(std::move(partial_sum));
                 }
 
-                std::vector<polynomial<FieldValueType>> grouped_addends_coefs(grouped_addends.size());
-
-                nil::crypto3::parallel_for(0, grouped_addends.size(), [&grouped_addends_coefs, &grouped_addends] (std::size_t i) {
-                    grouped_addends_coefs[i] = grouped_addends[i].coefficients();
+                // The sums of the smaller sizes are extended to the largest domain on the cosets of their own
+                // domains, the sum of the largest size is not transformed at all.
+                nil::crypto3::parallel_for(0, grouped_addends.size(), [&grouped_addends, max_size](std::size_t i) {
+                    grouped_addends[i].resize(max_size);
                 }, ThreadPool::PoolLevel::HIGH);
 
-                // We can parallelize this by adding pairwise, like it's done in multiplication, but it's pretty fast
-                // so skipping it for now.
-                polynomial<FieldValueType> coef_result;
-                for (const auto& partial_sum : grouped_addends_coefs) {
-                    coef_result += partial_sum;
+                std::size_t degree = 0;
+                for (const auto& partial_sum : grouped_addends) {
+                    degree = std::max(degree, partial_sum.degree());
                 }
 
-                polynomial_dfs<FieldValueType> dfs_result;
-                dfs_result.from_coefficients(coef_result.get_storage());
+                // All the sums are added in one pass over the result.
+                std::vector<FieldValueType> values = std::move(grouped_addends[0].get_storage());
+                parallel_for_chunks(max_size, [&values, &grouped_addends](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = 1; i < grouped_addends.size(); ++i) {
+                        const auto& partial_sum = grouped_addends[i];
+                        for (std::size_t t = begin; t < end; ++t) {
+                            values[t] += partial_sum[t];
+                        }
+                    }
+                });
 
-                return dfs_result;
+                return polynomial_dfs<FieldValueType>(degree, std::move(values));
             }
 
             template<typename FieldType>
@@ -889,10 +1167,10 @@ namespace nil {
                     domain_cache[i] = nullptr;
                 }
 
-                // We cannot use LOW level thread pool here, make_evaluation_domain uses it.
+                // We cannot use LOW level thread pool here, get_evaluation_domain uses it.
                 parallel_foreach(needed_domain_sizes.begin(), needed_domain_sizes.end(),
                     [&domain_cache](std::size_t domain_size) {
-                        domain_cache[domain_size] = make_evaluation_domain<FieldType>(domain_size);
+                        domain_cache[domain_size] = get_evaluation_domain<FieldType>(domain_size);
                     }, ThreadPool::PoolLevel::HIGH);
 
                 for (std::size_t stride = 1; stride < multipliers.size(); stride <<= 1) {
@@ -30,6 +30,8 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <cstdint>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
@@ -75,6 +77,54 @@ namespace nil {
 
                 return f_shifted;
             }
+
+            /**
+             * Read-only view of the values of polynomial_shift(f, shift, domain_size), without the copy. Element
+             * 'index' is read from f[(index + domain_scale * shift) mod f.size()]. Rotated columns of a plonk table
+             * are only read point by point, so the evaluators read them through this view, one stored column
+             * serves all of its rotations. 'f' must outlive the view.
+             */
+            template<typename PolynomialDFSType>
+            class polynomial_dfs_shift_view {
+            public:
+                typedef typename PolynomialDFSType::value_type value_type;
+                typedef typename PolynomialDFSType::size_type size_type;
+
+                polynomial_dfs_shift_view(const PolynomialDFSType &f, const int shift, std::size_t domain_size = 0)
+                    : f(&f) {
+                    const std::size_t extended_domain_size = f.size();
+                    if (domain_size == 0) {
+                        domain_size = extended_domain_size;
+                    }
+
+                    assert((extended_domain_size % domain_size) == 0);
+
+                    const std::size_t domain_scale = extended_domain_size / domain_size;
+                    const std::size_t rotation = (shift % std::int64_t(domain_size) + domain_size) % domain_size;
+                    offset = (domain_scale * rotation) % extended_domain_size;
+                }
+
+                const value_type &operator[](std::size_t index) const {
+                    // Both index and offset are less than the size, no division needed.
+                    std::size_t i = index + offset;
+                    if (i >= f->size()) {
+                        i -= f->size();
+                    }
+                    return (*f)[i];
+                }
+
+                size_type size() const {
+                    return f->size();
+                }
+
+                size_type degree() const {
+                    return f->degree();
+                }
+
+            private:
+                const PolynomialDFSType *f;
+                std::size_t offset;
+            };
         }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
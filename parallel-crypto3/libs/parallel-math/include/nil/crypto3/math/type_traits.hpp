@@ -56,8 +56,8 @@ namespace nil {
             template<typename T>
             struct is_polynomial_dfs : std::integral_constant<bool, false> {};
 
-            template<typename FieldValueType>
-            struct is_polynomial_dfs<nil::crypto3::math::polynomial_dfs<FieldValueType>> : std::integral_constant<bool, true> { };
+            template<typename FieldValueType, typename Allocator>
+            struct is_polynomial_dfs<nil::crypto3::math::polynomial_dfs<FieldValueType, Allocator>> : std::integral_constant<bool, true> { };
 
         }    // namespace math
     }        // namespace crypto3
@@ -33,6 +33,7 @@
 
 
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/math/algorithms/fft.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
@@ -42,6 +43,8 @@
 
 #include <nil/crypto3/algebra/random_element.hpp>
 
+#include <nil/actor/core/pool_allocator.hpp>
+
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
 
@@ -111,6 +114,114 @@ BOOST_AUTO_TEST_CASE(basic_radix2_domain_benchmark, *boost::unit_test::disabled(
               << " ms" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(blocked_fft_equals_radix2_fft) {
+    using value_type = FieldType::value_type;
+
+    // Small sizes fit in one block, the large ones have both the row and the column stages.
+    for (std::size_t log_size : {1, 5, 12, 15, 16, 17}) {
+        const std::size_t size = std::size_t(1) << log_size;
+        std::vector<value_type> data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = nil::crypto3::algebra::random_element<FieldType>();
+        }
+
+        std::vector<value_type> omega_cache;
+        detail::create_fft_cache<FieldType>(size, unity_root<FieldType>(size), omega_cache);
+
+        std::vector<value_type> expected = data;
+        detail::basic_radix2_fft_cached<FieldType>(expected, omega_cache);
+        std::vector<value_type> blocked = data;
+        detail::blocked_radix2_fft_cached<FieldType>(blocked, omega_cache);
+        BOOST_CHECK(blocked == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix2_domain_fft_algorithms) {
+    using value_type = FieldType::value_type;
+    const std::size_t size = 1 << 15;
+
+    std::vector<value_type> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+
+    basic_radix2_domain<FieldType> domain(size);
+    BOOST_CHECK(domain.get_fft_algorithm() == basic_radix2_domain<FieldType>::fft_algorithm::cache_blocked);
+    std::vector<value_type> blocked = data;
+    domain.fft(blocked);
+
+    basic_radix2_domain<FieldType> radix2_domain(size, basic_radix2_domain<FieldType>::fft_algorithm::radix2);
+    BOOST_CHECK(radix2_domain.get_fft_algorithm() == basic_radix2_domain<FieldType>::fft_algorithm::radix2);
+    std::vector<value_type> expected = data;
+    radix2_domain.fft(expected);
+    BOOST_CHECK(blocked == expected);
+
+    domain.inverse_fft(blocked);
+    BOOST_CHECK(blocked == data);
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix2_domain_fft_with_allocator) {
+    using value_type = FieldType::value_type;
+    using pooled_vector = std::vector<value_type, nil::crypto3::pool_allocator<value_type>>;
+    const std::size_t size = 1 << 16;
+
+    std::vector<value_type> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+
+    // The radix-2 domain transforms the pooled vector in place, any other domain through a copy.
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(size);
+    std::vector<value_type> expected = data;
+    domain->fft(expected);
+    pooled_vector pooled(data.begin(), data.end());
+    fft(domain, pooled);
+    BOOST_CHECK(std::equal(pooled.begin(), pooled.end(), expected.begin(), expected.end()));
+    inverse_fft(domain, pooled);
+    BOOST_CHECK(std::equal(pooled.begin(), pooled.end(), data.begin(), data.end()));
+
+    std::shared_ptr<evaluation_domain<FieldType>> geometric_domain =
+        std::make_shared<geometric_sequence_domain<FieldType>>(8);
+    std::vector<value_type> small_expected(data.begin(), data.begin() + 8);
+    geometric_domain->fft(small_expected);
+    pooled_vector small_pooled(data.begin(), data.begin() + 8);
+    fft(geometric_domain, small_pooled);
+    BOOST_CHECK(std::equal(small_pooled.begin(), small_pooled.end(), small_expected.begin(), small_expected.end()));
+}
+
+BOOST_AUTO_TEST_CASE(basic_radix2_domain_fft_batch) {
+    using value_type = FieldType::value_type;
+
+    // Small columns are transformed one per task, the large ones one after another.
+    for (std::size_t log_size : {4, 15}) {
+        const std::size_t size = std::size_t(1) << log_size;
+        basic_radix2_domain<FieldType> domain(size);
+
+        // The last column is shorter than the domain, it is padded with zeros.
+        std::vector<std::vector<value_type>> columns(5, std::vector<value_type>(size));
+        columns.back().resize(size / 2);
+        for (auto &column : columns) {
+            for (auto &value : column) {
+                value = nil::crypto3::algebra::random_element<FieldType>();
+            }
+        }
+
+        std::vector<std::vector<value_type>> expected = columns;
+        for (auto &column : expected) {
+            domain.fft(column);
+        }
+        std::vector<std::vector<value_type>> batch = columns;
+        domain.fft_batch(batch);
+        BOOST_CHECK(batch == expected);
+
+        for (auto &column : expected) {
+            domain.inverse_fft(column);
+        }
+        domain.inverse_fft_batch(batch);
+        BOOST_CHECK(batch == expected);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(fft_vs_multiplication_benchmark) {
     using value_type = FieldType::value_type;
     const std::size_t fft_size = 1 << 16;
@@ -149,4 +260,30 @@ BOOST_AUTO_TEST_CASE(fft_vs_multiplication_benchmark) {
              << " ms" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(evaluation_domain_cache_test) {
+    using value_type = FieldType::value_type;
+    auto &cache = evaluation_domain_cache<FieldType>::instance();
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.memory_usage(), 0);
+
+    auto domain = get_evaluation_domain<FieldType>(1 << 10);
+    BOOST_CHECK(domain == get_evaluation_domain<FieldType>(1 << 10));
+    BOOST_CHECK(domain != get_evaluation_domain<FieldType>(1 << 11));
+    BOOST_CHECK(cache.memory_usage() >= 2 * ((1 << 10) + (1 << 11)) * sizeof(value_type));
+
+    // The shared twiddles give the same transform as a domain of its own.
+    std::vector<value_type> data(1 << 10);
+    for (auto &value : data) {
+        value = nil::crypto3::algebra::random_element<FieldType>();
+    }
+    std::vector<value_type> expected = data;
+    make_evaluation_domain<FieldType>(1 << 10)->fft(expected);
+    domain->fft(data);
+    BOOST_CHECK(data == expected);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.memory_usage(), 0);
+    BOOST_CHECK(domain != get_evaluation_domain<FieldType>(1 << 10));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
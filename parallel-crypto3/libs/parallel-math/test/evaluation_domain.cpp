@@ -177,6 +177,53 @@ void test_inverse_coset_ftt_of_coset_fft() {
     }
 }
 
+template<typename FieldType>
+void test_evaluate_on_cosets() {
+    typedef typename FieldType::value_type value_type;
+    const std::size_t m = 8;
+    const std::size_t blowup = 4;
+    std::vector<value_type> f = {2u, 5u, 3u, 8u, 1u, 7u, 4u, 6u};
+
+    std::shared_ptr<evaluation_domain<FieldType>> domain = make_evaluation_domain<FieldType>(m);
+    std::shared_ptr<evaluation_domain<FieldType>> extended_domain = make_evaluation_domain<FieldType>(m * blowup);
+
+    std::vector<value_type> extended(f);
+    extended_domain->fft(extended);
+
+    // Only the odd cosets.
+    const value_type omega = extended_domain->get_unity_root();
+    std::vector<value_type> shifts = {omega, omega.pow(3)};
+    std::vector<std::vector<value_type>> cosets = evaluate_on_cosets<FieldType>(f, domain, shifts);
+
+    BOOST_CHECK_EQUAL(cosets.size(), shifts.size());
+    for (std::size_t j = 0; j < m; j++) {
+        BOOST_CHECK_EQUAL(cosets[0][j].data, extended[j * blowup + 1].data);
+        BOOST_CHECK_EQUAL(cosets[1][j].data, extended[j * blowup + 3].data);
+    }
+
+    // One coset at a time in a reused buffer, the buffer is resized from the previous coset.
+    std::vector<value_type> coset(1);
+    for (std::size_t r = 0; r < blowup; r++) {
+        evaluate_on_coset<FieldType>(f, domain, omega.pow(r), coset);
+        BOOST_CHECK_EQUAL(coset.size(), m);
+        for (std::size_t j = 0; j < m; j++) {
+            BOOST_CHECK_EQUAL(coset[j].data, extended[j * blowup + r].data);
+        }
+    }
+
+    // A polynomial of degree above the size of the domain is folded, its coefficients are a multiple of the size.
+    std::vector<value_type> g = {2u, 5u, 3u, 8u, 1u, 7u, 4u, 6u, 9u, 1u, 2u, 7u, 3u, 3u, 5u, 8u};
+    std::vector<value_type> g_extended(g);
+    g_extended.resize(m * blowup, value_type::zero());
+    extended_domain->fft(g_extended);
+    for (std::size_t r = 0; r < blowup; r++) {
+        evaluate_on_coset<FieldType>(g, domain, omega.pow(r), coset);
+        for (std::size_t j = 0; j < m; j++) {
+            BOOST_CHECK_EQUAL(coset[j].data, g_extended[j * blowup + r].data);
+        }
+    }
+}
+
 template<typename FieldType>
 void test_lagrange_coefficients() {
     typedef typename FieldType::value_type value_type;
@@ -410,6 +457,11 @@ BOOST_AUTO_TEST_CASE(inverse_coset_ftt_to_coset_fft) {
     test_inverse_coset_ftt_of_coset_fft<fields::goldilocks64>();
 }
 
+BOOST_AUTO_TEST_CASE(evaluate_on_cosets_test) {
+    test_evaluate_on_cosets<fields::bls12_scalar_field<381>>();
+    test_evaluate_on_cosets<fields::goldilocks64>();
+}
+
 BOOST_AUTO_TEST_CASE(lagrange_coefficients) {
     test_lagrange_coefficients<fields::bls12<381>>();
     test_lagrange_coefficients<fields::mnt4<298>>();
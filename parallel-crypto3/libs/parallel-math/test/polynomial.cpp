@@ -228,4 +228,40 @@ BOOST_AUTO_TEST_SUITE(polynomial_division_test_suite)
         test_division({4u, 0u, 4u, 2u, 2u}, {2u}, {2u, 0u, 2u, 1u, 1u}, {0u});
     }
 
+    BOOST_AUTO_TEST_CASE(polynomial_division_large_divisor) {
+        typedef typename FieldType::value_type value_type;
+
+        // Large enough to use the Newton iteration.
+        polynomial<value_type> a(1000), b(300);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            a[i] = value_type(i * i + 7 * i + 3);
+        }
+        for (std::size_t i = 0; i < b.size(); ++i) {
+            b[i] = value_type(5 * i + 1);
+        }
+
+        auto Q = a / b;
+        auto R = a % b;
+
+        BOOST_CHECK_EQUAL(Q.size(), a.size() - b.size() + 1);
+        BOOST_CHECK(R.size() < b.size());
+        BOOST_CHECK_EQUAL(Q * b + R, a);
+    }
+
+    BOOST_AUTO_TEST_CASE(polynomial_division_by_linear) {
+        typedef typename FieldType::value_type value_type;
+
+        polynomial<value_type> a = {2u, 0u, 3u, 2u, 1u};
+        std::vector<value_type> points = {2u, 0u, FieldType::modulus - 1u, 5u};
+
+        value_type remainder;
+        BOOST_CHECK_EQUAL(division_by_linear(a, points[0], remainder), polynomial<value_type>({22u, 11u, 4u, 1u}));
+        BOOST_CHECK_EQUAL(remainder, value_type(46u));
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            polynomial<value_type> quotient = division_by_linear(a, points[i], remainder);
+            BOOST_CHECK_EQUAL(remainder, a.evaluate(points[i]));
+            BOOST_CHECK_EQUAL(quotient, a / polynomial<value_type>({-points[i], value_type::one()}));
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,8 @@
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
 #include <nil/crypto3/math/polynomial/xgcd.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+#include <nil/crypto3/math/algorithms/grand_product.hpp>
 
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
@@ -371,3 +373,43 @@ BOOST_AUTO_TEST_CASE(extended_gcd) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(grand_product_test_suite)
+
+BOOST_AUTO_TEST_CASE(batch_inversion_test) {
+    std::vector<typename ScalarFieldType::value_type> values;
+    for (std::size_t i = 1; i <= 1000; ++i) {
+        values.push_back(typename ScalarFieldType::value_type(i * i + 7));
+    }
+    std::vector<typename ScalarFieldType::value_type> inverses = values;
+
+    nil::crypto3::math::batch_inversion(inverses);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        BOOST_CHECK(values[i] * inverses[i] == ScalarFieldType::value_type::one());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(grand_product_test) {
+    std::vector<typename ScalarFieldType::value_type> numerators;
+    std::vector<typename ScalarFieldType::value_type> denominators;
+    for (std::size_t i = 1; i <= 1000; ++i) {
+        numerators.push_back(typename ScalarFieldType::value_type(3 * i + 1));
+        denominators.push_back(typename ScalarFieldType::value_type(5 * i + 2));
+    }
+
+    std::vector<typename ScalarFieldType::value_type> expected(numerators.size());
+    typename ScalarFieldType::value_type product = ScalarFieldType::value_type::one();
+    for (std::size_t i = 0; i < numerators.size(); ++i) {
+        product *= numerators[i] * denominators[i].inversed();
+        expected[i] = product;
+    }
+
+    nil::crypto3::math::grand_product(numerators.begin(), numerators.end(), denominators.begin(), numerators.begin());
+
+    for (std::size_t i = 0; i < numerators.size(); ++i) {
+        BOOST_CHECK(numerators[i] == expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
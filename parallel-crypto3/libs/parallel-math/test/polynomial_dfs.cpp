@@ -41,6 +41,7 @@
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/first_touch_allocator.hpp>
 
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
@@ -271,6 +272,60 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_sum) {
     }
     BOOST_CHECK_EQUAL(native_sum, polynomial_sum<FieldType>(polynomials));
 }
+
+BOOST_AUTO_TEST_CASE(polynomial_sum_different_sizes) {
+    using value_type = typename FieldType::value_type;
+
+    // Several addends of each size, the largest size has a single addend.
+    std::vector<polynomial_dfs<value_type>> polynomials;
+    polynomial<value_type> expected = {0u};
+    for (std::size_t size : {4, 16, 4, 8, 64, 16, 1}) {
+        polynomial<value_type> coefficients(size);
+        for (auto& c : coefficients) {
+            c = random_element<FieldType>();
+        }
+        expected += coefficients;
+
+        polynomial_dfs<value_type> poly;
+        poly.from_coefficients(coefficients);
+        polynomials.push_back(poly);
+    }
+
+    polynomial_dfs<value_type> sum = polynomial_sum<FieldType>(polynomials);
+    BOOST_CHECK_EQUAL(sum.size(), 64);
+    BOOST_CHECK_EQUAL(sum.degree(), 63);
+    BOOST_CHECK_EQUAL(polynomial<value_type>(sum.coefficients()), expected);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_fused_apply) {
+    using value_type = typename FieldType::value_type;
+
+    polynomial_dfs<value_type> a(15, 16), b(15, 16), c(3, 16);
+    for (std::size_t i = 0; i < 16; ++i) {
+        a[i] = random_element<FieldType>();
+        b[i] = random_element<FieldType>();
+        c[i] = random_element<FieldType>();
+    }
+    value_type beta = random_element<FieldType>();
+    value_type gamma = random_element<FieldType>();
+
+    polynomial_dfs<value_type> expected = a;
+    expected *= beta;
+    expected += gamma;
+    expected += b;
+    expected += c;
+
+    a.fused_apply(15, [&beta, &gamma](value_type& x, const value_type& y, const value_type& z) {
+        x = x * beta + gamma + y + z;
+    }, b, c);
+    BOOST_CHECK_EQUAL(a.degree(), 15);
+    BOOST_CHECK(a == expected);
+
+    polynomial_dfs<value_type> d(3, 8);
+    BOOST_CHECK_THROW(a.fused_apply(15, [](value_type& x, const value_type& y) { x += y; }, d),
+                      std::invalid_argument);
+    BOOST_CHECK(a == expected);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(polynomial_dfs_addition_eq_test_suite)
@@ -1115,6 +1170,26 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_shift) {
 
     }
 }
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_shift_view_test) {
+    polynomial_dfs<typename FieldType::value_type> a = {
+        3, {0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u,
+            0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu, 0x10u}};
+
+    // Same values as the copy, on the own domain and on a 4 times smaller domain, with negative rotations.
+    for (std::size_t domain_size : {a.size(), a.size() / 4}) {
+        for (int shift = -3; shift <= 3; shift++) {
+            polynomial_dfs<typename FieldType::value_type> a_shifted = polynomial_shift(a, shift, domain_size);
+            polynomial_dfs_shift_view<polynomial_dfs<typename FieldType::value_type>> a_view(a, shift, domain_size);
+
+            BOOST_CHECK_EQUAL(a_view.size(), a_shifted.size());
+            BOOST_CHECK_EQUAL(a_view.degree(), a_shifted.degree());
+            for (std::size_t i = 0; i < a_shifted.size(); i++) {
+                BOOST_CHECK(a_view[i] == a_shifted[i]);
+            }
+        }
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(polynomial_dfs_operations_with_constants_test_suite)
@@ -1280,6 +1355,170 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_after_resize_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_barycentric_test) {
+    using value_type = typename FieldType::value_type;
+
+    const std::size_t size = 1 << 10;
+    polynomial<value_type> coefficients(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        coefficients[i] = random_element<FieldType>();
+    }
+    polynomial_dfs<value_type> poly;
+    poly.from_coefficients(coefficients);
+
+    value_type point = random_element<FieldType>();
+    BOOST_CHECK(poly.evaluate(point) == coefficients.evaluate(point));
+
+    // A point of the domain.
+    value_type omega = unity_root<FieldType>(size);
+    BOOST_CHECK(poly.evaluate(omega.pow(5)) == poly[5]);
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_batch_test) {
+    using value_type = typename FieldType::value_type;
+
+    std::vector<polynomial_dfs<value_type>> polys;
+    for (std::size_t size : {1, 16, 16, 16, 64}) {
+        polynomial_dfs<value_type> poly(size - 1, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            poly[i] = random_element<FieldType>();
+        }
+        polys.push_back(poly);
+    }
+
+    value_type shared = random_element<FieldType>();
+    std::vector<std::vector<value_type>> points(polys.size());
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        points[i] = {shared, random_element<FieldType>()};
+    }
+    points[2].push_back(unity_root<FieldType>(16));
+
+    std::vector<const polynomial_dfs<value_type>*> poly_ptrs;
+    std::vector<const std::vector<value_type>*> point_ptrs;
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        poly_ptrs.push_back(&polys[i]);
+        point_ptrs.push_back(&points[i]);
+    }
+    std::vector<std::vector<value_type>> result = evaluate_batch(poly_ptrs, point_ptrs);
+
+    BOOST_CHECK_EQUAL(result.size(), polys.size());
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        polynomial<value_type> coefficients(polys[i].coefficients());
+        BOOST_CHECK_EQUAL(result[i].size(), points[i].size());
+        for (std::size_t j = 0; j < points[i].size(); ++j) {
+            BOOST_CHECK(result[i][j] == coefficients.evaluate(points[i][j]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_constant_test) {
+    using value_type = typename FieldType::value_type;
+
+    // Degree 0 polynomials hold the same value in all the points of the domain.
+    value_type c = random_element<FieldType>();
+    std::vector<polynomial_dfs<value_type>> polys;
+    for (std::size_t size : {1, 16, 64}) {
+        polys.emplace_back(0, size, c);
+    }
+    for (std::size_t size : {16, 64}) {
+        polynomial_dfs<value_type> poly(size - 1, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            poly[i] = random_element<FieldType>();
+        }
+        polys.push_back(poly);
+    }
+
+    value_type shared = random_element<FieldType>();
+    std::vector<std::vector<value_type>> points(polys.size());
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        points[i] = {shared, random_element<FieldType>(), unity_root<FieldType>(16)};
+    }
+
+    std::vector<const polynomial_dfs<value_type>*> poly_ptrs;
+    std::vector<const std::vector<value_type>*> point_ptrs;
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        poly_ptrs.push_back(&polys[i]);
+        point_ptrs.push_back(&points[i]);
+    }
+    std::vector<std::vector<value_type>> result = evaluate_batch(poly_ptrs, point_ptrs);
+
+    BOOST_CHECK_EQUAL(result.size(), polys.size());
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        polynomial<value_type> coefficients(polys[i].coefficients());
+        BOOST_CHECK_EQUAL(result[i].size(), points[i].size());
+        for (std::size_t j = 0; j < points[i].size(); ++j) {
+            BOOST_CHECK(result[i][j] == polys[i].evaluate(points[i][j]));
+            BOOST_CHECK(result[i][j] == coefficients.evaluate(points[i][j]));
+            if (i < 3) {
+                BOOST_CHECK(result[i][j] == c);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_resize_with_allocator_test) {
+    using value_type = typename FieldType::value_type;
+    using first_touch_polynomial_dfs = polynomial_dfs<value_type, nil::crypto3::first_touch_allocator<value_type>>;
+
+    const std::size_t size = 1 << 10;
+    polynomial_dfs<value_type> poly(size - 1, size);
+    for (std::size_t i = 0; i < size; ++i) {
+        poly[i] = random_element<FieldType>();
+    }
+    first_touch_polynomial_dfs first_touch_poly(poly.degree(), poly.begin(), poly.end());
+
+    // The large size goes through the first touch path of the allocator.
+    const std::size_t extended_size = 1 << 16;
+    poly.resize(extended_size);
+    first_touch_poly.resize(extended_size);
+    BOOST_CHECK(std::equal(poly.begin(), poly.end(), first_touch_poly.begin(), first_touch_poly.end()));
+
+    poly.resize(size);
+    first_touch_poly.resize(size);
+    BOOST_CHECK(std::equal(poly.begin(), poly.end(), first_touch_poly.begin(), first_touch_poly.end()));
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_resize_with_allocator_domain_test) {
+    using value_type = typename FieldType::value_type;
+    using first_touch_polynomial_dfs = polynomial_dfs<value_type, nil::crypto3::first_touch_allocator<value_type>>;
+
+    const std::size_t size = 8;
+    polynomial_dfs<value_type> poly(size - 1, size * 2);
+    for (std::size_t i = 0; i < poly.size(); ++i) {
+        poly[i] = random_element<FieldType>();
+    }
+    first_touch_polynomial_dfs first_touch_poly(poly.degree(), poly.begin(), poly.end());
+
+    // Not a radix-2 domain, the storage of the first touch polynomial goes through a std::vector.
+    std::shared_ptr<evaluation_domain<FieldType>> domain =
+        std::make_shared<geometric_sequence_domain<FieldType>>(size);
+    poly.resize(size, nullptr, domain);
+    first_touch_poly.resize(size, nullptr, domain);
+    BOOST_CHECK(std::equal(poly.begin(), poly.end(), first_touch_poly.begin(), first_touch_poly.end()));
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_dfs_resize_batch_test) {
+    using value_type = typename FieldType::value_type;
+
+    // Polynomials of different sizes, a constant one and one that already has the new size.
+    std::vector<polynomial_dfs<value_type>> polys;
+    for (std::size_t size : {8, 16, 8, 1, 64}) {
+        polynomial_dfs<value_type> poly(size - 1, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            poly[i] = random_element<FieldType>();
+        }
+        polys.push_back(poly);
+    }
+
+    const std::size_t new_size = 64;
+    std::vector<polynomial_dfs<value_type>> expected = polys;
+    for (auto &poly : expected) {
+        poly.resize(new_size);
+    }
+    resize_batch<FieldType>(polys, new_size);
+    BOOST_CHECK(polys == expected);
+}
+
 BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_after_resize_and_shift_test) {
 
     polynomial_dfs<typename FieldType::value_type> small_poly = {
@@ -40,6 +40,7 @@
 
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
+#include <nil/crypto3/math/type_traits.hpp>
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
@@ -222,17 +223,42 @@ namespace nil {
                             for (std::size_t i = 0; i < poly.size(); ++i) {
                                 _z.set_poly_points_number(k, i, point[i].size());
                             }
+                        }
+
+                        if constexpr (math::is_polynomial_dfs<polynomial_type>::value) {
+                            // All the batches are evaluated together, so the polynomials of different batches opened
+                            // at the same point share the Lagrange basis values at it.
+                            std::vector<const polynomial_type*> polys;
+                            std::vector<const std::vector<value_type>*> points;
+                            for (auto const &[k, poly] : _polys) {
+                                auto const &point = _points.at(k);
+                                for (std::size_t i = 0; i < poly.size(); ++i) {
+                                    polys.push_back(&poly[i]);
+                                    points.push_back(&point[i]);
+                                }
+                            }
 
-                            // Lambda in parallel_for can not capture structured bindings [k, poly], until C++20
-                            auto k_capture = k;
-                            auto poly_capture = poly;
+                            std::vector<std::vector<value_type>> evaluations = math::evaluate_batch(polys, points);
 
-                            // We use HIGH level thread pool here, because "evaluate" may use the lower level one.
-                            parallel_for(0, poly.size(), [this, &point, k_capture, &poly_capture](std::size_t i) {
-                                for (std::size_t j = 0; j < point[i].size(); j++) {
-                                    _z.set(k_capture, i, j, poly_capture[i].evaluate(point[i][j]));
+                            std::size_t index = 0;
+                            for (auto const &[k, poly] : _polys) {
+                                for (std::size_t i = 0; i < poly.size(); ++i, ++index) {
+                                    for (std::size_t j = 0; j < evaluations[index].size(); j++) {
+                                        _z.set(k, i, j, evaluations[index][j]);
+                                    }
                                 }
-                            }, ThreadPool::PoolLevel::HIGH);
+                            }
+                        } else {
+                            for (auto const &[k, poly] : _polys) {
+                                auto const &point = _points.at(k);
+
+                                // We use HIGH level thread pool here, because "evaluate" may use the lower level one.
+                                parallel_for(0, poly.size(), [this, &point, k = k, &poly = poly](std::size_t i) {
+                                    for (std::size_t j = 0; j < point[i].size(); j++) {
+                                        _z.set(k, i, j, poly[i].evaluate(point[i][j]));
+                                    }
+                                }, ThreadPool::PoolLevel::HIGH);
+                            }
                         }
                     }
 
@@ -48,6 +48,7 @@
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
+#include <nil/crypto3/math/type_traits.hpp>
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 #include <nil/crypto3/container/merkle/proof.hpp>
@@ -498,7 +499,7 @@ namespace nil {
                                         FRI>::value,
                                 bool>::type = true>
                 static typename std::enable_if<
-                        (std::is_same<typename ContainerType::value_type, math::polynomial_dfs<typename FRI::field_type::value_type>>::value),
+                        (math::is_polynomial_dfs<typename ContainerType::value_type>::value),
                         typename FRI::precommitment_type>::type
                 precommit(ContainerType poly,
                           std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> D,
@@ -506,32 +507,24 @@ namespace nil {
                 ) {
                     PROFILE_SCOPE("Basic FRI Precommit time");
 
-                    // Resize uses low level thread pool, so we need to use the high level one here.
-                    parallel_for(0, poly.size(), [&poly, &D](std::size_t i) {
-                        if (poly[i].size() != D->size()) {
-                            poly[i].resize(D->size(), nullptr, D);
-                        }
-                    }, ThreadPool::PoolLevel::HIGH);
+                    math::resize_batch<typename FRI::field_type>(poly, D->size(), D);
 
                     std::size_t domain_size = D->size();
                     std::size_t list_size = poly.size();
                     std::size_t coset_size = 1 << fri_step;
                     std::size_t leafs_number = domain_size / coset_size;
-                    std::vector<detail::fri_field_element_consumer<FRI>> y_data(
-                        leafs_number,
-                        detail::fri_field_element_consumer<FRI>(coset_size * list_size)
-                    );
 
-                    parallel_for(0, leafs_number, [&y_data, &poly, domain_size, coset_size, list_size](std::size_t x_index) {
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
+                    // The leaves are hashed as they are read from the polynomials, which may be in memory mapped
+                    // files, so they are never all in memory at once.
+                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(
+                        leafs_number,
+                        detail::fri_field_element_consumer<FRI>(coset_size * list_size),
+                        [&poly, domain_size, coset_size, list_size](
+                                std::size_t x_index, detail::fri_field_element_consumer<FRI>& leaf) {
                             std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
                             s_indices[0][0] = x_index;
                             s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
 
-                            element_consumer.consume(poly[polynom_index][s_indices[0][0]]);
-                            element_consumer.consume(poly[polynom_index][s_indices[0][1]]);
-
                             std::size_t base_index = domain_size / (FRI::m * FRI::m);
                             std::size_t prev_half_size = 1;
                             std::size_t i = 1;
@@ -539,19 +532,20 @@ namespace nil {
                                 for (std::size_t j = 0; j < prev_half_size; j++) {
                                     s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
                                     s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][0]]);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][1]]);
-
                                     i++;
                                 }
                                 base_index /= FRI::m;
                                 prev_half_size <<= 1;
                             }
-                        }
-                    });
 
-                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
-                                                                                                     y_data.end());
+                            auto& element_consumer = leaf.reset_cursor();
+                            for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
+                                for (const auto& indices : s_indices) {
+                                    element_consumer.consume(poly[polynom_index][indices[0]]);
+                                    element_consumer.consume(poly[polynom_index][indices[1]]);
+                                }
+                            }
+                        });
                 }
 
                 template<typename FRI, typename ContainerType,
@@ -576,10 +570,9 @@ namespace nil {
                     std::vector<math::polynomial_dfs<typename FRI::field_type::value_type>> poly_dfs(list_size);
                     for (std::size_t i = 0; i < list_size; i++) {
                         poly_dfs[i].from_coefficients(poly[i]);
-                        poly_dfs[i].resize(D->size(), nullptr, D);
                     }
 
-                    return precommit<FRI>(poly_dfs, D, fri_step);
+                    return precommit<FRI>(std::move(poly_dfs), D, fri_step);
                 }
 
                 template<typename FRI>
@@ -820,7 +813,7 @@ namespace nil {
 
                         parallel_for(0, required_domains.size(),
                             [&required_domains, &d_cache](std::size_t i) {
-                            d_cache[required_domains[i]] = math::make_evaluation_domain<typename FRI::field_type>(required_domains[i]);
+                            d_cache[required_domains[i]] = math::get_evaluation_domain<typename FRI::field_type>(required_domains[i]);
                         }, ThreadPool::PoolLevel::HIGH);
 
                         parallel_for(0, key_index_pairs.size(),
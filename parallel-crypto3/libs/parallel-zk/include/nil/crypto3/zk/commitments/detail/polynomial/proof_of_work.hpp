@@ -74,7 +74,7 @@ namespace nil {
                         std::atomic<std::size_t> pow_value_offset;
 
                         while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
+                            parallel_for_chunks(
                                 per_block,
                                 [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
                                     std::size_t i = pow_start;
@@ -94,7 +94,7 @@ namespace nil {
                                         }
                                         ++i;
                                     }
-                                }, ThreadPool::PoolLevel::LOW));
+                                }, ThreadPool::PoolLevel::LOW);
 
                             if (challenge_found) {
                                 break;
@@ -145,7 +145,7 @@ namespace nil {
                         std::atomic<std::size_t> pow_value_offset;
 
                         while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
+                            parallel_for_chunks(
                                 per_block,
                                 [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
                                     std::size_t i = pow_start;
@@ -165,7 +165,7 @@ namespace nil {
                                         }
                                         ++i;
                                     }
-                                }, ThreadPool::PoolLevel::LOW));
+                                }, ThreadPool::PoolLevel::LOW);
 
                             if (challenge_found) {
                                 break;
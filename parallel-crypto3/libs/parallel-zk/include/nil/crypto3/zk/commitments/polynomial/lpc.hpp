@@ -34,6 +34,10 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <set>
+
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
 
@@ -43,6 +47,7 @@
 #include <nil/crypto3/zk/commitments/batched_commitment.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/basic_fri.hpp>
 
+#include <nil/actor/core/mapped_file_allocator.hpp>
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
 
@@ -86,6 +91,8 @@ namespace nil {
                     value_type _etha;
                     std::map<std::size_t, bool> _batch_fixed;
                     preprocessed_data_type _fixed_polys_values;
+                    // Batches whose extension to D[0] for the Merkle tree is kept in memory mapped files.
+                    std::set<std::size_t> _batch_in_files;
 
                 public:
                     // Getters for the upper fields. Used from marshalling only so far.
@@ -144,11 +151,46 @@ namespace nil {
                     commitment_type commit(std::size_t index) {
                         this->state_commited(index);
 
+                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value) {
+                            if (_batch_in_files.find(index) != _batch_in_files.end()) {
+                                using mapped_polynomial_type =
+                                    math::polynomial_dfs<value_type, mapped_file_allocator<value_type>>;
+                                // The batch is moved to the files and its memory is released for the time of the
+                                // extension and the Merkle tree. Its values are saved in the files as well, since
+                                // the extension overwrites the copy moved into precommit, and are read back for
+                                // the evaluations.
+                                std::vector<mapped_polynomial_type> saved_polys;
+                                std::vector<mapped_polynomial_type> extended_polys;
+                                saved_polys.reserve(this->_polys[index].size());
+                                extended_polys.reserve(this->_polys[index].size());
+                                for (auto& poly : this->_polys[index]) {
+                                    saved_polys.emplace_back(poly.degree(), poly.begin(), poly.end());
+                                    extended_polys.emplace_back(poly.degree(), poly.begin(), poly.end());
+                                    poly = PolynomialType();
+                                }
+                                _trees[index] = nil::crypto3::zk::algorithms::precommit<fri_type>(
+                                    std::move(extended_polys), _fri_params.D[0], _fri_params.step_list.front());
+                                for (std::size_t i = 0; i < saved_polys.size(); ++i) {
+                                    this->_polys[index][i] = PolynomialType(
+                                        saved_polys[i].degree(), saved_polys[i].begin(), saved_polys[i].end());
+                                }
+                                return _trees[index].root();
+                            }
+                        }
+
                         _trees[index] = nil::crypto3::zk::algorithms::precommit<fri_type>(
                             this->_polys[index], _fri_params.D[0], _fri_params.step_list.front());
                         return _trees[index].root();
                     }
 
+                    // The polynomials of the batch extended to D[0] for its commitment are kept in memory mapped
+                    // files instead of the memory, see mapped_file_allocator, and the batch itself is kept there
+                    // while they are. For the batches whose extension does not fit in the memory, must be called
+                    // before commit.
+                    void store_batch_in_files(std::size_t index) {
+                        _batch_in_files.insert(index);
+                    }
+
                     // Should be done after commitment.
                     void mark_batch_as_fixed(std::size_t index) {
                         _batch_fixed[index] = true;
@@ -283,11 +325,21 @@ namespace nil {
                             std::size_t starting_power = 0) {
                         this->build_points_map();
 
-                        typename field_type::value_type theta_acc = theta.pow(starting_power);
-                        polynomial_type combined_Q;
-                        math::polynomial<value_type> V;
-
                         auto points = this->get_unique_points();
+
+                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value) {
+                            return prepare_combined_Q_dfs(theta, starting_power, points);
+                        } else {
+                            return prepare_combined_Q_normal(theta, starting_power, points);
+                        }
+                    }
+
+                    // Computes combined_Q in coefficient form, for PolynomialType = math::polynomial.
+                    polynomial_type prepare_combined_Q_normal(
+                            const typename field_type::value_type& theta,
+                            std::size_t starting_power,
+                            const std::vector<value_type>& points) {
+                        polynomial_type combined_Q;
                         math::polynomial<value_type> combined_Q_normal;
 
                         std::vector<math::polynomial<value_type>> Q_normals(points.size());
@@ -319,33 +371,7 @@ namespace nil {
                             theta_powers.push_back(current_power);
                         }
 
-                        // If PolynomialType is DFS type, we need to convert this->polys to coefficients form,
-                        // otherwise we do nothing. After this block polys_coefficients_ptr must be used,
-                        // it will point to this->_polys if no conversion is required, or to polys_coefficients
-                        // if conversion was required.
-                        std::map<std::size_t, std::vector<math::polynomial<value_type>>> polys_coefficients;
-                        std::map<std::size_t, std::vector<math::polynomial<value_type>>>* polys_coefficients_ptr;
-
-                        if constexpr(std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value ) {
-                            // Convert this->_polys to coefficients form.
-                            std::vector<std::pair<std::size_t, std::size_t>> indices;
-                            for (const auto& [i, V]: this->_polys) {
-                                polys_coefficients[i].resize(V.size());
-                                for (std::size_t j = 0; j < V.size(); ++j) {
-                                    indices.push_back({i, j});
-                                }
-                            }
-
-                            parallel_for(0, indices.size(), [this, &indices, &polys_coefficients](std::size_t i) {
-                                polys_coefficients[indices[i].first][indices[i].second] =
-                                    this->_polys[indices[i].first][indices[i].second].coefficients();
-                            }, ThreadPool::PoolLevel::HIGH);
-
-                            polys_coefficients_ptr = &polys_coefficients;
-                        } else {
-                            polys_coefficients_ptr = &this->_polys;
-                        }
-
+                        std::map<std::size_t, std::vector<math::polynomial<value_type>>>* polys_coefficients_ptr = &this->_polys;
                         std::vector<std::vector<math::polynomial<value_type>>> Q_normal_parts(
                             points.size(), std::vector<math::polynomial<value_type>>(this->_z.get_batches().size()));
 
@@ -377,9 +403,9 @@ namespace nil {
                             for(std::size_t batch_index = 0; batch_index < this->_z.get_batches().size(); ++batch_index) {
                                 Q_normal += Q_normal_parts[point_index][batch_index];
                             }
-                            auto const &point = points[point_index];
-                            math::polynomial<value_type> V = {-point, 1};
-                            Q_normal = Q_normal / V;
+                            // Q_normal(point) is zero, the remainder is dropped.
+                            value_type remainder;
+                            Q_normal = math::division_by_linear(Q_normal, points[point_index], remainder);
                         }, ThreadPool::PoolLevel::HIGH);
 
                         for (const auto& Q_normal: Q_normals) {
@@ -400,8 +426,6 @@ namespace nil {
                             if( _batch_fixed.find(i) == _batch_fixed.end() || !_batch_fixed[i] )
                                 return;
                             math::polynomial<value_type>& Q_normal = Q_normals[batch_idx];
-                            auto point = _etha;
-                            math::polynomial<value_type> V = {-point, 1u};
 
                             for(std::size_t j = 0; j < this->_z.get_batch_size(i); j++){
                                 math::polynomial<value_type> g_normal = (*polys_coefficients_ptr)[i][j];
@@ -411,25 +435,148 @@ namespace nil {
                                 theta_acc *= theta;
                             }
 
-                            Q_normal = Q_normal / V;
+                            value_type remainder;
+                            Q_normal = math::division_by_linear(Q_normal, _etha, remainder);
                         }, ThreadPool::PoolLevel::HIGH);
 
                         for (const auto& Q_normal: Q_normals) {
                             combined_Q_normal += Q_normal;
                         }
 
-                        if constexpr (std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value) {
-                            combined_Q.from_coefficients(combined_Q_normal);
-                            if (combined_Q.size() != _fri_params.D[0]->size()) {
-                                combined_Q.resize(_fri_params.D[0]->size(), nullptr, _fri_params.D[0]);
+                        combined_Q = std::move(combined_Q_normal);
+
+                        return combined_Q;
+                    }
+
+                    /** \brief Same as prepare_combined_Q, but the polynomials are kept in evaluation form.
+                     *  The polynomials of each size are added up with their powers of theta on their own domain, the
+                     *  sum is divided by (x - point) pointwise, and only the sums for the different sizes are
+                     *  extended to D[0].
+                     */
+                    polynomial_type prepare_combined_Q_dfs(
+                            const typename field_type::value_type& theta,
+                            std::size_t starting_power,
+                            const std::vector<value_type>& points) {
+                        PROFILE_SCOPE("LPC prepare combined_Q");
+
+                        // Q_parts[size] is the part of combined_Q that comes from the polynomials of this size.
+                        std::map<std::size_t, std::vector<value_type>> Q_parts;
+                        std::vector<std::tuple<const polynomial_type*, value_type, value_type>> terms;
+
+                        value_type theta_acc = theta.pow(starting_power);
+                        std::size_t current_power = starting_power;
+                        for (auto const &point: points) {
+                            terms.clear();
+                            for (std::size_t i: this->_z.get_batches()) {
+                                for (std::size_t j = 0; j < this->_z.get_batch_size(i); j++) {
+                                    auto iter = this->_points_map[i][j].find(point);
+                                    if (iter == this->_points_map[i][j].end())
+                                        continue;
+
+                                    terms.emplace_back(&this->_polys[i][j], theta_acc, this->_z.get(i, j, iter->second));
+                                    theta_acc *= theta;
+                                    current_power++;
+                                }
+                            }
+                            add_quotient_dfs(point, terms, Q_parts);
+                        }
+
+                        // The powers of theta must match the ones in prepare_combined_Q.
+                        std::vector<std::size_t> theta_powers = {current_power};
+                        for (std::size_t i : this->_z.get_batches()) {
+                            theta_powers.push_back(theta_powers.back() + this->_z.get_batch_size(i));
+                        }
+                        terms.clear();
+                        for (std::size_t i : this->_z.get_batches()) {
+                            if (_batch_fixed.find(i) == _batch_fixed.end() || !_batch_fixed[i])
+                                continue;
+                            theta_acc = theta.pow(theta_powers[i]);
+                            for (std::size_t j = 0; j < this->_z.get_batch_size(i); j++) {
+                                terms.emplace_back(&this->_polys[i][j], theta_acc, _fixed_polys_values[i][j]);
+                                theta_acc *= theta;
                             }
-                        } else {
-                            combined_Q = std::move(combined_Q_normal);
                         }
+                        add_quotient_dfs(_etha, terms, Q_parts);
 
+                        polynomial_type combined_Q(0, _fri_params.D[0]->size(), value_type::zero());
+                        for (auto &[size, values]: Q_parts) {
+                            polynomial_type part(size > 1 ? size - 2 : 0, std::move(values));
+                            if (size != _fri_params.D[0]->size()) {
+                                part.resize(_fri_params.D[0]->size(), nullptr, _fri_params.D[0]);
+                            }
+                            combined_Q += part;
+                        }
                         return combined_Q;
                     }
 
+                    /** \brief Adds sum_k theta_k * (f_k(x) - z_k) / (x - point) to Q_parts[size] for the terms
+                     *  (f_k, theta_k, z_k) with f_k of this size, on the domain of that size. Since z_k = f_k(point),
+                     *  the quotient has degree less than the size, so its values on the domain define it.
+                     */
+                    void add_quotient_dfs(
+                            const value_type& point,
+                            const std::vector<std::tuple<const polynomial_type*, value_type, value_type>>& terms,
+                            std::map<std::size_t, std::vector<value_type>>& Q_parts) const {
+                        std::map<std::size_t, std::vector<std::size_t>> terms_by_size;
+                        for (std::size_t k = 0; k < terms.size(); ++k) {
+                            terms_by_size[std::get<0>(terms[k])->size()].push_back(k);
+                        }
+
+                        for (auto const &[size, indices]: terms_by_size) {
+                            value_type shift = value_type::zero();
+                            for (std::size_t k: indices) {
+                                shift += std::get<1>(terms[k]) * std::get<2>(terms[k]);
+                            }
+
+                            std::vector<value_type> numerator(size);
+                            parallel_for_chunks(size, [&terms, &indices = indices, &numerator, &shift](std::size_t begin, std::size_t end) {
+                                for (std::size_t t = begin; t < end; ++t) {
+                                    numerator[t] = -shift;
+                                }
+                                for (std::size_t k: indices) {
+                                    const polynomial_type& f = *std::get<0>(terms[k]);
+                                    const value_type& theta_k = std::get<1>(terms[k]);
+                                    for (std::size_t t = begin; t < end; ++t) {
+                                        numerator[t] += theta_k * f[t];
+                                    }
+                                }
+                            });
+
+                            if (point.pow(size) == value_type::one()) {
+                                // 'point' is on the domain, divide in coefficient form.
+                                math::polynomial<value_type> numerator_normal(
+                                    polynomial_type(size - 1, std::move(numerator)).coefficients());
+                                value_type remainder;
+                                numerator_normal = math::division_by_linear(numerator_normal, point, remainder);
+                                polynomial_type quotient;
+                                quotient.from_coefficients(numerator_normal);
+                                quotient.resize(size);
+                                numerator.assign(quotient.begin(), quotient.end());
+                            } else {
+                                const value_type omega = math::unity_root<field_type>(size);
+                                std::vector<value_type> denominators(size);
+                                parallel_for_chunks(size, [&denominators, &omega, &point](std::size_t begin, std::size_t end) {
+                                    value_type omega_t = omega.pow(begin);
+                                    for (std::size_t t = begin; t < end; ++t) {
+                                        denominators[t] = omega_t - point;
+                                        omega_t *= omega;
+                                    }
+                                });
+                                math::batch_inversion(denominators);
+                                in_place_parallel_transform(numerator.begin(), numerator.end(), denominators.begin(),
+                                    [](value_type& v1, const value_type& v2){v1 *= v2;});
+                            }
+
+                            std::vector<value_type>& part = Q_parts[size];
+                            if (part.empty()) {
+                                part = std::move(numerator);
+                            } else {
+                                in_place_parallel_transform(part.begin(), part.end(), numerator.begin(),
+                                    [](value_type& v1, const value_type& v2){v1 += v2;});
+                            }
+                        }
+                    }
+
                     // Computes and returns the maximal power of theta used to compute the value of Combined_Q.
                     std::size_t compute_theta_power_for_combined_Q() {
                         std::size_t theta_power = 0;
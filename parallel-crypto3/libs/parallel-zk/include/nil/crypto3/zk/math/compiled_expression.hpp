@@ -0,0 +1,385 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_MATH_COMPILED_EXPRESSION_HPP
+#define PARALLEL_CRYPTO3_ZK_MATH_COMPILED_EXPRESSION_HPP
+
+#ifdef CRYPTO3_ZK_MATH_COMPILED_EXPRESSION_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <nil/crypto3/zk/math/expression.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /**
+             * An expression over field values lowered to a flat register program, for evaluating the same
+             * expression on many rows, like the gate constraints on the extended domain.
+             *
+             * The expression tree is compiled once: each variable is loaded once, constant subexpressions are
+             * folded, equal subexpressions are computed once, powers become multiplications and the values
+             * that are no longer needed free their registers for the next ones. The program is then run over
+             * blocks of rows, so each instruction is dispatched once per block and its loop over the rows
+             * does no lookups.
+             */
+            template<typename VariableType>
+            class compiled_expression {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                // Number of rows evaluated by one pass over the program.
+                static constexpr std::size_t block_size = 64;
+
+                enum class opcode : std::uint8_t {
+                    LOAD = 0,
+                    ADD = 1,
+                    SUB = 2,
+                    MULT = 3
+                };
+
+                // Operand of an instruction: a register, or an index in the constants.
+                struct operand {
+                    bool is_constant;
+                    std::uint32_t index;
+
+                    bool operator<(const operand& other) const {
+                        return std::tie(is_constant, index) < std::tie(other.is_constant, other.index);
+                    }
+                };
+
+                // 'dst' = 'a' op 'b'. For LOAD, 'a.index' is the index of the variable in variables().
+                struct instruction {
+                    opcode op;
+                    std::uint32_t dst;
+                    operand a;
+                    operand b;
+                };
+
+                compiled_expression(const math::expression<VariableType>& expr) {
+                    compiler c(*this);
+                    operand result = boost::apply_visitor(c, expr.get_expr());
+                    c.finish(result);
+                }
+
+                // Variables of the expression. The columns passed to evaluate() must be in this order.
+                const std::vector<VariableType>& variables() const {
+                    return _variables;
+                }
+
+                const std::vector<instruction>& instructions() const {
+                    return _instructions;
+                }
+
+                std::size_t registers_count() const {
+                    return _registers_count;
+                }
+
+                /**
+                 * Writes the value of the expression at the rows [begin, end) to out[begin, end).
+                 * columns[i] is the column of variables()[i], anything with operator[] over the rows.
+                 */
+                template<typename ColumnType, typename OutputType>
+                void evaluate(const std::vector<const ColumnType*>& columns,
+                              std::size_t begin, std::size_t end, OutputType& out) const {
+                    BOOST_ASSERT(columns.size() == _variables.size());
+
+                    std::vector<ValueType> registers(_registers_count * block_size);
+                    for (std::size_t start = begin; start < end; start += block_size) {
+                        const std::size_t n = std::min(block_size, end - start);
+
+                        for (const instruction& ins : _instructions) {
+                            ValueType* dst = &registers[ins.dst * block_size];
+                            if (ins.op == opcode::LOAD) {
+                                const ColumnType& column = *columns[ins.a.index];
+                                for (std::size_t r = 0; r < n; ++r) {
+                                    dst[r] = column[start + r];
+                                }
+                                continue;
+                            }
+
+                            // Constants are read with stride 0.
+                            auto [a, a_stride] = get_operand(registers, ins.a);
+                            auto [b, b_stride] = get_operand(registers, ins.b);
+                            switch (ins.op) {
+                                case opcode::ADD:
+                                    for (std::size_t r = 0; r < n; ++r) {
+                                        dst[r] = a[r * a_stride] + b[r * b_stride];
+                                    }
+                                    break;
+                                case opcode::SUB:
+                                    for (std::size_t r = 0; r < n; ++r) {
+                                        dst[r] = a[r * a_stride] - b[r * b_stride];
+                                    }
+                                    break;
+                                case opcode::MULT:
+                                    for (std::size_t r = 0; r < n; ++r) {
+                                        dst[r] = a[r * a_stride] * b[r * b_stride];
+                                    }
+                                    break;
+                                default:
+                                    break;
+                            }
+                        }
+
+                        auto [result, result_stride] = get_operand(registers, _result);
+                        for (std::size_t r = 0; r < n; ++r) {
+                            out[start + r] = result[r * result_stride];
+                        }
+                    }
+                }
+
+            private:
+                std::pair<const ValueType*, std::size_t> get_operand(
+                        const std::vector<ValueType>& registers, const operand& op) const {
+                    if (op.is_constant) {
+                        return {&_constants[op.index], 0};
+                    }
+                    return {&registers[op.index * block_size], 1};
+                }
+
+                // Lowers the expression tree to instructions in SSA form, where register i is written only by
+                // instruction i, then allocates the registers.
+                class compiler : public boost::static_visitor<operand> {
+                public:
+                    compiler(compiled_expression& program) : program(program) {
+                    }
+
+                    operand operator()(const math::term<VariableType>& term) {
+                        // Sorted, so that a * b and b * a are the same subexpression.
+                        std::vector<VariableType> vars = term.get_vars();
+                        std::sort(vars.begin(), vars.end());
+
+                        operand result = constant(term.get_coeff());
+                        for (const VariableType& var : vars) {
+                            result = emit(opcode::MULT, result, load(var));
+                        }
+                        return result;
+                    }
+
+                    operand operator()(const math::pow_operation<VariableType>& pow) {
+                        operand base = boost::apply_visitor(*this, pow.get_expr().get_expr());
+                        // Square and multiply, the squarings of the leading one are folded away.
+                        const unsigned power = pow.get_power();
+                        operand result = constant(ValueType::one());
+                        for (int bit = 8 * sizeof(unsigned) - 1; bit >= 0; --bit) {
+                            result = emit(opcode::MULT, result, result);
+                            if ((power >> bit) & 1) {
+                                result = emit(opcode::MULT, result, base);
+                            }
+                        }
+                        return result;
+                    }
+
+                    operand operator()(const math::binary_arithmetic_operation<VariableType>& op) {
+                        operand left = boost::apply_visitor(*this, op.get_expr_left().get_expr());
+                        operand right = boost::apply_visitor(*this, op.get_expr_right().get_expr());
+                        switch (op.get_op()) {
+                            case ArithmeticOperator::ADD:
+                                return emit(opcode::ADD, left, right);
+                            case ArithmeticOperator::SUB:
+                                return emit(opcode::SUB, left, right);
+                            case ArithmeticOperator::MULT:
+                                return emit(opcode::MULT, left, right);
+                            default:
+                                throw std::invalid_argument("ArithmeticOperator not found");
+                        }
+                    }
+
+                    // Drops the instructions the result does not depend on, and maps the SSA values to as few
+                    // registers as possible.
+                    void finish(operand result) {
+                        std::vector<bool> live(ssa.size(), false);
+                        if (!result.is_constant) {
+                            live[result.index] = true;
+                        }
+                        for (std::size_t i = ssa.size(); i-- > 0;) {
+                            if (!live[i] || ssa[i].op == opcode::LOAD) {
+                                continue;
+                            }
+                            for (const operand& arg : {ssa[i].a, ssa[i].b}) {
+                                if (!arg.is_constant) {
+                                    live[arg.index] = true;
+                                }
+                            }
+                        }
+
+                        // The last instruction reading each SSA value.
+                        std::vector<std::size_t> last_use(ssa.size(), 0);
+                        for (std::size_t i = 0; i < ssa.size(); ++i) {
+                            if (!live[i] || ssa[i].op == opcode::LOAD) {
+                                continue;
+                            }
+                            for (const operand& arg : {ssa[i].a, ssa[i].b}) {
+                                if (!arg.is_constant) {
+                                    last_use[arg.index] = i;
+                                }
+                            }
+                        }
+                        if (!result.is_constant) {
+                            last_use[result.index] = ssa.size();
+                        }
+
+                        // The instructions work row by row, so the destination can be one of the operands
+                        // read for the last time.
+                        std::vector<std::uint32_t> reg(ssa.size());
+                        std::vector<std::uint32_t> free_registers;
+                        std::uint32_t registers_count = 0;
+                        for (std::size_t i = 0; i < ssa.size(); ++i) {
+                            if (!live[i]) {
+                                continue;
+                            }
+                            instruction ins = ssa[i];
+                            if (ins.op != opcode::LOAD) {
+                                std::vector<std::uint32_t> freed;
+                                for (operand* arg : {&ins.a, &ins.b}) {
+                                    if (arg->is_constant) {
+                                        continue;
+                                    }
+                                    std::uint32_t ssa_index = arg->index;
+                                    arg->index = reg[ssa_index];
+                                    if (last_use[ssa_index] == i &&
+                                            std::find(freed.begin(), freed.end(), ssa_index) == freed.end()) {
+                                        freed.push_back(ssa_index);
+                                        free_registers.push_back(arg->index);
+                                    }
+                                }
+                            }
+                            if (free_registers.empty()) {
+                                reg[i] = registers_count++;
+                            } else {
+                                reg[i] = free_registers.back();
+                                free_registers.pop_back();
+                            }
+                            ins.dst = reg[i];
+                            program._instructions.push_back(ins);
+                        }
+
+                        program._registers_count = registers_count;
+                        program._result = result;
+                        if (!result.is_constant) {
+                            program._result.index = reg[result.index];
+                        }
+                    }
+
+                private:
+                    operand constant(const ValueType& value) {
+                        auto it = constants.find(value);
+                        if (it != constants.end()) {
+                            return {true, it->second};
+                        }
+                        std::uint32_t index = program._constants.size();
+                        program._constants.push_back(value);
+                        constants[value] = index;
+                        return {true, index};
+                    }
+
+                    operand load(const VariableType& var) {
+                        auto it = variables.find(var);
+                        std::uint32_t index;
+                        if (it != variables.end()) {
+                            index = it->second;
+                        } else {
+                            index = program._variables.size();
+                            program._variables.push_back(var);
+                            variables[var] = index;
+                        }
+                        return emit(opcode::LOAD, {true, index}, {true, 0});
+                    }
+
+                    const ValueType& value(const operand& op) const {
+                        return program._constants[op.index];
+                    }
+
+                    operand emit(opcode op, operand a, operand b) {
+                        if (op != opcode::LOAD) {
+                            // Constant folding.
+                            if (a.is_constant && b.is_constant) {
+                                switch (op) {
+                                    case opcode::ADD:
+                                        return constant(value(a) + value(b));
+                                    case opcode::SUB:
+                                        return constant(value(a) - value(b));
+                                    default:
+                                        return constant(value(a) * value(b));
+                                }
+                            }
+                            if (op != opcode::SUB) {
+                                // Commutative, constants go to the right.
+                                if (a.is_constant || (!b.is_constant && b < a)) {
+                                    std::swap(a, b);
+                                }
+                                if (op == opcode::MULT && b.is_constant && value(b) == ValueType::zero()) {
+                                    return b;
+                                }
+                                if ((op == opcode::MULT && b.is_constant && value(b) == ValueType::one()) ||
+                                    (op == opcode::ADD && b.is_constant && value(b) == ValueType::zero())) {
+                                    return a;
+                                }
+                            } else if (b.is_constant && value(b) == ValueType::zero()) {
+                                return a;
+                            }
+                        }
+
+                        // Equal subexpressions are the same instruction.
+                        auto key = std::make_tuple(op, a.is_constant, a.index, b.is_constant, b.index);
+                        auto it = emitted.find(key);
+                        if (it != emitted.end()) {
+                            return {false, it->second};
+                        }
+                        std::uint32_t index = ssa.size();
+                        ssa.push_back({op, index, a, b});
+                        emitted[key] = index;
+                        return {false, index};
+                    }
+
+                    compiled_expression& program;
+                    std::vector<instruction> ssa;
+                    std::map<std::tuple<opcode, bool, std::uint32_t, bool, std::uint32_t>, std::uint32_t> emitted;
+                    std::unordered_map<ValueType, std::uint32_t> constants;
+                    std::unordered_map<VariableType, std::uint32_t> variables;
+                };
+
+                std::vector<VariableType> _variables;
+                std::vector<ValueType> _constants;
+                std::vector<instruction> _instructions;
+                std::size_t _registers_count = 0;
+                operand _result = {true, 0};
+            };
+        }    // namespace math
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_MATH_COMPILED_EXPRESSION_HPP
@@ -32,7 +32,10 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
 #include <nil/crypto3/zk/math/permutation.hpp>
@@ -65,12 +68,15 @@ namespace nil {
                                                  std::shared_ptr<math::evaluation_domain<FieldType>>
                                                      domain) {
 
-                        std::size_t columns_amount = column_range_assignment.size();
-                        std::vector<math::polynomial<typename FieldType::value_type>> columns(columns_amount);
+                        std::vector<std::vector<typename FieldType::value_type>> interpolation_points(
+                            column_range_assignment.begin(), column_range_assignment.end());
 
-                        for (std::size_t column_index = 0; column_index < columns_amount; column_index++) {
-                            columns[column_index] =
-                                column_polynomial<FieldType>(column_range_assignment[column_index], domain);
+                        domain->inverse_fft_batch(interpolation_points);
+
+                        std::vector<math::polynomial<typename FieldType::value_type>> columns;
+                        columns.reserve(interpolation_points.size());
+                        for (auto &points : interpolation_points) {
+                            columns.emplace_back(std::move(points));
                         }
 
                         return columns;
@@ -93,12 +99,28 @@ namespace nil {
                         return columns;
                     }
 
+                    /**
+                     * Returns the degree of the polynomial_dfs of a column. Columns with the same value in all the
+                     * rows, like zero padding or unused selectors, are constant polynomials. They get degree 0, so
+                     * they are resized with a fill and evaluated with a lookup instead of FFTs, everywhere later.
+                     */
+                    template<typename FieldType>
+                    std::size_t column_polynomial_dfs_degree(const plonk_column<FieldType>& column_assignment) {
+                        if (column_assignment.size() <= 1) {
+                            return 0;
+                        }
+                        const auto& first = column_assignment.front();
+                        bool is_constant = std::all_of(column_assignment.begin(), column_assignment.end(),
+                            [&first](const typename FieldType::value_type& value) { return value == first; });
+                        return is_constant ? 0 : column_assignment.size() - 1;
+                    }
+
                     template<typename FieldType>
                     math::polynomial_dfs<typename FieldType::value_type>
                         column_polynomial_dfs(const plonk_column<FieldType>& column_assignment,
                                               std::shared_ptr<math::evaluation_domain<FieldType>> domain) {
 
-                        std::size_t d = std::distance(column_assignment.begin(), column_assignment.end()) - 1;
+                        std::size_t d = column_polynomial_dfs_degree<FieldType>(column_assignment);
 
                         nil::crypto3::math::polynomial_dfs<typename FieldType::value_type> res(
                             d, column_assignment.begin(), column_assignment.end());
@@ -117,9 +139,11 @@ namespace nil {
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> columns(columns_amount);
 
                         for (std::size_t column_index = 0; column_index < columns_amount; column_index++) {
-                            columns[column_index] =
-                                column_polynomial_dfs<FieldType>(column_range_assignment[column_index], domain);
+                            const auto &column = column_range_assignment[column_index];
+                            columns[column_index] = math::polynomial_dfs<typename FieldType::value_type>(
+                                column_polynomial_dfs_degree<FieldType>(column), column.begin(), column.end());
                         }
+                        math::resize_batch<FieldType>(columns, domain->size(), domain);
 
                         return columns;
                     }
@@ -134,9 +158,11 @@ namespace nil {
                         std::array<math::polynomial_dfs<typename FieldType::value_type>, columns_amount> columns;
 
                         for (std::size_t column_index = 0; column_index < columns_amount; column_index++) {
-                            columns[column_index] =
-                                column_polynomial_dfs<FieldType>(std::move(column_range_assignment[column_index]), domain);
+                            const auto &column = column_range_assignment[column_index];
+                            columns[column_index] = math::polynomial_dfs<typename FieldType::value_type>(
+                                column_polynomial_dfs_degree<FieldType>(column), column.begin(), column.end());
                         }
+                        math::resize_batch<FieldType>(columns, domain->size(), domain);
 
                         return columns;
                     }
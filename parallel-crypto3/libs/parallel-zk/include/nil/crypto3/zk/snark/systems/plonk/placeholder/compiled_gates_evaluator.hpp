@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_PLONK_PLACEHOLDER_COMPILED_GATES_EVALUATOR_HPP
+#define PARALLEL_CRYPTO3_ZK_PLONK_PLACEHOLDER_COMPILED_GATES_EVALUATOR_HPP
+
+#ifdef CRYPTO3_ZK_PLONK_PLACEHOLDER_COMPILED_GATES_EVALUATOR_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * Gate evaluator of one constraint system, compiled ahead of time. The transpiler prints it as a C++
+                 * translation unit (see gates_evaluator_cpp_printer), which registers it in compiled_gates_evaluators
+                 * when it is linked into or loaded by the prover.
+                 */
+                template<typename FieldType>
+                struct compiled_gates_evaluator {
+                    using value_type = typename FieldType::value_type;
+                    using variable_type = plonk_variable<value_type>;
+
+                    // For 'rows' rows, writes to result[r] the sum over the gates of
+                    // selector * sum(theta_powers[k] * constraint_k), where k counts the constraints of all the gates
+                    // in order. values[i * rows + r] is the value of variables[i] at row r.
+                    using evaluate_type = void (*)(const value_type* values, std::size_t rows,
+                                                   const value_type* theta_powers, value_type* result);
+
+                    std::vector<variable_type> variables;
+                    std::size_t constraints_count;
+                    evaluate_type evaluate;
+                };
+
+                /**
+                 * Process-wide registry of compiled gate evaluators, keyed by the printed
+                 * constraint_system_with_params_hash of the verification key. Constraint systems without
+                 * a compiled evaluator are evaluated by placeholder_gates_argument from their expressions.
+                 */
+                template<typename FieldType>
+                class compiled_gates_evaluators {
+                public:
+                    using evaluator_type = compiled_gates_evaluator<FieldType>;
+
+                    static compiled_gates_evaluators& instance() {
+                        // Never destroyed, the evaluators register themselves from static initializers.
+                        static compiled_gates_evaluators* evaluators = new compiled_gates_evaluators();
+                        return *evaluators;
+                    }
+
+                    template<typename DigestType>
+                    static std::string key(const DigestType& constraint_system_with_params_hash) {
+                        std::stringstream ss;
+                        ss << constraint_system_with_params_hash;
+                        return ss.str();
+                    }
+
+                    void add(const std::string& constraint_system_hash, const evaluator_type& evaluator) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        evaluators[constraint_system_hash] = evaluator;
+                    }
+
+                    // Returns nullptr if there is no compiled evaluator for the constraint system.
+                    const evaluator_type* find(const std::string& constraint_system_hash) const {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        auto it = evaluators.find(constraint_system_hash);
+                        return it == evaluators.end() ? nullptr : &it->second;
+                    }
+
+                private:
+                    compiled_gates_evaluators() = default;
+
+                    mutable std::mutex mutex;
+                    // Node based, the pointers returned by find() stay valid.
+                    std::unordered_map<std::string, evaluator_type> evaluators;
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_COMPILED_GATES_EVALUATOR_HPP
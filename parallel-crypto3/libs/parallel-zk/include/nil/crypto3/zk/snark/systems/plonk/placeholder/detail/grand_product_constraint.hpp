@@ -0,0 +1,200 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Evaluation of the grand product constraint of the permutation and lookup arguments.
+//
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_CONSTRAINT_HPP
+#define PARALLEL_CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_CONSTRAINT_HPP
+
+#ifdef CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_CONSTRAINT_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <nil/crypto3/math/coset.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/fft.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/detail/field_utils.hpp>
+
+#include <nil/actor/core/pool_allocator.hpp>
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+
+                    /**
+                     * Evaluates the constraint of a grand product V split into parts,
+                     *
+                     *     (q_last + q_blind - 1) * (sum_{i < k - 1} alpha_i * (V_i * g_i - V_{i + 1} * h_i)
+                     *                               + V_{k - 1} * g_{k - 1} - V_shifted * h_{k - 1}),
+                     *
+                     * where k is the number of parts, g_i and h_i are the products of the factors of part i, V_0 = V
+                     * and V_i are the partial products committed for the parts. With one part it is the constraint
+                     * (1 - q_last - q_blind) * (V_shifted * h - V * g).
+                     *
+                     * The products g_i and h_i have the degree of all their factors, so they are never built. The
+                     * constraint is evaluated on the extended domain one coset of the basic domain H at a time, like
+                     * the gate argument: the factors are interpolated once, and on each coset every part takes one
+                     * FFT of size |H| per factor, folded into a product buffer of size |H| that is reused by the
+                     * next coset. The factors may be given on domains larger than H.
+                     */
+                    template<typename FieldType>
+                    math::polynomial_dfs<typename FieldType::value_type> grand_product_constraint(
+                        std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain,
+                        std::vector<std::vector<math::polynomial_dfs<typename FieldType::value_type>>> g_factors,
+                        std::vector<std::vector<math::polynomial_dfs<typename FieldType::value_type>>> h_factors,
+                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &partial_products,
+                        const math::polynomial_dfs<typename FieldType::value_type> &shifted_product,
+                        const std::vector<typename FieldType::value_type> &alphas,
+                        const math::polynomial_dfs<typename FieldType::value_type> &q_last,
+                        const math::polynomial_dfs<typename FieldType::value_type> &q_blind
+                    ) {
+                        using value_type = typename FieldType::value_type;
+                        using polynomial_dfs_type = math::polynomial_dfs<value_type>;
+                        using coefficients_type = std::vector<value_type, pool_allocator<value_type>>;
+
+                        const std::size_t parts = g_factors.size();
+                        const std::size_t n = basic_domain->m;
+                        BOOST_ASSERT(h_factors.size() == parts);
+                        BOOST_ASSERT(partial_products.size() == parts);
+                        BOOST_ASSERT(alphas.size() + 1 == parts);
+
+                        // The degree of the masked difference, the bound of the old product of the polynomials.
+                        std::size_t degree = 0;
+                        for (std::size_t i = 0; i < parts; ++i) {
+                            std::size_t g_degree = 0;
+                            std::size_t h_degree = 0;
+                            for (const auto &factor : g_factors[i])
+                                g_degree += factor.degree();
+                            for (const auto &factor : h_factors[i])
+                                h_degree += factor.degree();
+                            degree = std::max(degree, 2 * (n - 1) + std::max(g_degree, h_degree));
+                        }
+                        const std::size_t extended_size = std::max(n, math::detail::power_of_two(degree + 1));
+                        const std::size_t cosets_count = extended_size / n;
+
+                        // The coefficients of all the factors, the values of a factor are dropped when it is interpolated.
+                        std::vector<std::vector<coefficients_type>> g_coefficients(parts);
+                        std::vector<std::vector<coefficients_type>> h_coefficients(parts);
+                        std::vector<std::pair<polynomial_dfs_type*, coefficients_type*>> interpolations;
+                        for (std::size_t i = 0; i < parts; ++i) {
+                            g_coefficients[i].resize(g_factors[i].size());
+                            h_coefficients[i].resize(h_factors[i].size());
+                            for (std::size_t j = 0; j < g_factors[i].size(); ++j)
+                                interpolations.emplace_back(&g_factors[i][j], &g_coefficients[i][j]);
+                            for (std::size_t j = 0; j < h_factors[i].size(); ++j)
+                                interpolations.emplace_back(&h_factors[i][j], &h_coefficients[i][j]);
+                        }
+                        polynomial_dfs_type mask(0, n, -value_type::one());
+                        mask += q_last;
+                        mask += q_blind;
+                        std::vector<polynomial_dfs_type> products(partial_products);
+                        products.push_back(shifted_product);
+                        products.push_back(std::move(mask));
+                        std::vector<coefficients_type> products_coefficients(products.size());
+                        for (std::size_t i = 0; i < products.size(); ++i)
+                            interpolations.emplace_back(&products[i], &products_coefficients[i]);
+
+                        parallel_for(0, interpolations.size(), [&interpolations, n](std::size_t i) {
+                            polynomial_dfs_type &values = *interpolations[i].first;
+                            coefficients_type &coefficients = *interpolations[i].second;
+                            if (values.size() < n)
+                                values.resize(n);
+                            coefficients.assign(values.begin(), values.end());
+                            values = polynomial_dfs_type();
+                            math::inverse_fft(math::get_evaluation_domain<FieldType>(coefficients.size()), coefficients);
+                        }, ThreadPool::PoolLevel::HIGH);
+
+                        std::shared_ptr<math::evaluation_domain<FieldType>> extended_domain =
+                            math::get_evaluation_domain<FieldType>(extended_size);
+
+                        std::vector<coefficients_type> g_values(parts);
+                        std::vector<coefficients_type> h_values(parts);
+                        std::vector<coefficients_type> factor_values(parts);
+                        std::vector<coefficients_type> products_values(products.size());
+
+                        polynomial_dfs_type result(degree, extended_size);
+                        for (std::size_t s = 0; s < cosets_count; ++s) {
+                            const value_type shift = extended_domain->get_domain_element(s);
+
+                            auto evaluate_product = [&basic_domain, &shift, n](
+                                    const std::vector<coefficients_type> &factors,
+                                    coefficients_type &values, coefficients_type &factor) {
+                                if (factors.empty()) {
+                                    values.assign(n, value_type::one());
+                                    return;
+                                }
+                                math::evaluate_on_coset<FieldType>(factors[0], basic_domain, shift, values);
+                                for (std::size_t j = 1; j < factors.size(); ++j) {
+                                    math::evaluate_on_coset<FieldType>(factors[j], basic_domain, shift, factor);
+                                    for (std::size_t r = 0; r < values.size(); ++r)
+                                        values[r] *= factor[r];
+                                }
+                            };
+                            parallel_for(0, parts,
+                                [&](std::size_t i) {
+                                    evaluate_product(g_coefficients[i], g_values[i], factor_values[i]);
+                                    evaluate_product(h_coefficients[i], h_values[i], factor_values[i]);
+                                }, ThreadPool::PoolLevel::HIGH);
+                            parallel_for(0, products.size(),
+                                [&products_coefficients, &products_values, &basic_domain, &shift](std::size_t i) {
+                                    math::evaluate_on_coset<FieldType>(
+                                        products_coefficients[i], basic_domain, shift, products_values[i]);
+                                }, ThreadPool::PoolLevel::HIGH);
+
+                            const coefficients_type &shifted_values = products_values[parts];
+                            const coefficients_type &mask_values = products_values[parts + 1];
+                            parallel_for_chunks(n,
+                                [&, s](std::size_t begin, std::size_t end) {
+                                    for (std::size_t r = begin; r < end; ++r) {
+                                        value_type sum = value_type::zero();
+                                        for (std::size_t i = 0; i + 1 < parts; ++i) {
+                                            sum += alphas[i] * (products_values[i][r] * g_values[i][r] -
+                                                                products_values[i + 1][r] * h_values[i][r]);
+                                        }
+                                        sum += products_values[parts - 1][r] * g_values[parts - 1][r] -
+                                               shifted_values[r] * h_values[parts - 1][r];
+                                        result[r * cosets_count + s] = sum * mask_values[r];
+                                    }
+                                }, ThreadPool::PoolLevel::HIGH);
+                        }
+                        return result;
+                    }
+                }    // namespace detail
+            }    // namespace snark
+        }    // namespace zk
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_CONSTRAINT_HPP
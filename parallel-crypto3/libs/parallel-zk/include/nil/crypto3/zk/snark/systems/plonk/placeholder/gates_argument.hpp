@@ -32,6 +32,7 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
 #include <unordered_map>
 #include <iostream>
 #include <memory>
@@ -39,6 +40,7 @@
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/fft.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
 
@@ -51,13 +53,16 @@
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/compiled_gates_evaluator.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint.hpp>
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
+#include <nil/crypto3/zk/math/compiled_expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 
 #include <nil/crypto3/bench/scoped_profiler.hpp>
 
+#include <nil/actor/core/pool_allocator.hpp>
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
 
@@ -66,15 +71,24 @@ namespace nil {
         namespace zk {
             namespace snark {
 
-                template<typename FieldType, typename ParamsType, std::size_t ArgumentSize = 1>
+                // 'CoefficientsAllocator' allocates the buffers of the columns evaluated on the cosets.
+                template<typename FieldType, typename ParamsType, std::size_t ArgumentSize = 1,
+                         typename CoefficientsAllocator = pool_allocator<typename FieldType::value_type>>
                 struct placeholder_gates_argument;
 
-                template<typename FieldType, typename ParamsType>
-                struct placeholder_gates_argument<FieldType, ParamsType, 1> {
+                template<typename FieldType, typename ParamsType, typename CoefficientsAllocator>
+                struct placeholder_gates_argument<FieldType, ParamsType, 1, CoefficientsAllocator> {
 
                     typedef typename ParamsType::transcript_hash_type transcript_hash_type;
                     using transcript_type = transcript::fiat_shamir_heuristic_sequential<transcript_hash_type>;
                     using polynomial_dfs_type = math::polynomial_dfs<typename FieldType::value_type>;
+                    // Coefficients of a column and its values on a coset of the original domain, the gates are
+                    // evaluated one coset at a time. The same sizes are allocated in every proof, so the buffers come
+                    // from the pool by default, which also places the pages of a new buffer like
+                    // first_touch_allocator.
+                    using coefficients_type = std::vector<typename FieldType::value_type, CoefficientsAllocator>;
+                    using coset_values_type = coefficients_type;
+                    using coset_view_type = math::polynomial_dfs_shift_view<coset_values_type>;
                     using variable_type = plonk_variable<typename FieldType::value_type>;
                     using polynomial_dfs_variable_type = plonk_variable<polynomial_dfs_type>;
 
@@ -82,59 +96,157 @@ namespace nil {
 
                     constexpr static const std::size_t argument_size = 1;
 
-                    static inline void build_variable_value_map(
-                        const math::expression<variable_type>& expr,
+                    // Coefficients of the columns read by 'variables', with rotation 0. Constant columns keep only
+                    // their value, a single coefficient.
+                    static inline void build_column_coefficients(
+                        const std::vector<variable_type>& variables,
                         const plonk_polynomial_dfs_table<FieldType>& assignments,
                         std::shared_ptr<math::evaluation_domain<FieldType>> domain,
-                        std::size_t extended_domain_size,
-                        std::unordered_map<variable_type, polynomial_dfs_type>& variable_values_out,
                         const polynomial_dfs_type &mask_polynomial,
-                        const polynomial_dfs_type &lagrange_0
+                        const polynomial_dfs_type &lagrange_0,
+                        std::unordered_map<variable_type, coefficients_type>& coefficients_out
                     ) {
+                        std::vector<variable_type> columns;
+                        for (const variable_type& var : variables) {
+                            variable_type column(var.index, 0, var.relative, var.type);
+                            // Create the structure of the map, so its values can be filled in parallel.
+                            if (coefficients_out.find(column) == coefficients_out.end()) {
+                                coefficients_out[column] = {};
+                                columns.push_back(column);
+                            }
+                        }
 
-                        std::unordered_map<variable_type, size_t> variable_counts;
-                        std::vector<variable_type> variables;
-
-                        math::expression_for_each_variable_visitor<variable_type> visitor(
-                            [&variable_counts, &variables, &variable_values_out](const variable_type& var) {
-                                // Create the structure of the map so we can change the values later.
-                                if (variable_counts[var] == 0) {
-                                    variables.push_back(var);
-                                    // Create the structure of the map, so its values can be filled in parallel.
-                                    if (variable_values_out.find(var) == variable_values_out.end()) {
-                                        variable_values_out[var] = polynomial_dfs_type();
-                                    }
-                                }
-                                variable_counts[var]++;
-                        });
-
-                        visitor.visit(expr);
-
-                        std::shared_ptr<math::evaluation_domain<FieldType>> extended_domain =
-                            math::make_evaluation_domain<FieldType>(extended_domain_size);
-
-                        parallel_for(0, variables.size(),
-                            [&variables, &variable_values_out, &assignments, &domain, &extended_domain, extended_domain_size, &mask_polynomial, &lagrange_0](std::size_t i) {
-                                const variable_type& var = variables[i];
+                        parallel_for(0, columns.size(),
+                            [&columns, &coefficients_out, &assignments, &domain, &mask_polynomial, &lagrange_0](std::size_t i) {
+                                const variable_type& var = columns[i];
 
                                 // Convert the variable to polynomial_dfs variable type.
                                 polynomial_dfs_variable_type var_dfs(var.index, var.rotation, var.relative,
                                     static_cast<typename polynomial_dfs_variable_type::column_type>(
                                         static_cast<std::uint8_t>(var.type)));
 
-                                polynomial_dfs_type assignment;
+                                polynomial_dfs_type special_selector;
+                                const polynomial_dfs_type* assignment;
                                 if( var.index == PLONK_SPECIAL_SELECTOR_ALL_USABLE_ROWS_SELECTED && var.type == variable_type::column_type::selector){
-                                    assignment = mask_polynomial;
+                                    assignment = &mask_polynomial;
                                 } else if( var.index == PLONK_SPECIAL_SELECTOR_ALL_NON_FIRST_USABLE_ROWS_SELECTED && var.type == variable_type::column_type::selector) {
-                                    assignment = mask_polynomial - lagrange_0;
+                                    special_selector = mask_polynomial - lagrange_0;
+                                    assignment = &special_selector;
                                 } else
-                                    assignment = assignments.get_variable_value(var_dfs, domain);
+                                    assignment = &assignments.get_variable_value_without_rotation(var_dfs);
+
+                                coefficients_type& coefficients = coefficients_out.at(var);
+                                if (assignment->degree() == 0) {
+                                    coefficients.assign(1, (*assignment)[0]);
+                                    return;
+                                }
+                                coefficients.assign(assignment->begin(), assignment->end());
+                                coefficients.resize(domain->m, FieldType::value_type::zero());
+                                math::inverse_fft(domain, coefficients);
+                            }, ThreadPool::PoolLevel::HIGH);
+                    }
+
+                    // Values of the columns read by 'variables' on the coset 'shift' * H of the original domain H.
+                    // The buffers of 'column_values_out' are reused from the previous coset.
+                    static inline void build_coset_variable_value_map(
+                        const std::vector<variable_type>& variables,
+                        const std::unordered_map<variable_type, coefficients_type>& coefficients,
+                        std::shared_ptr<math::evaluation_domain<FieldType>> domain,
+                        const typename FieldType::value_type& shift,
+                        std::unordered_map<variable_type, coset_values_type>& column_values_out,
+                        std::unordered_map<variable_type, coset_view_type>& variable_values_out
+                    ) {
+                        std::vector<variable_type> columns;
+                        for (const variable_type& var : variables) {
+                            variable_type column(var.index, 0, var.relative, var.type);
+                            if (column_values_out.find(column) == column_values_out.end()) {
+                                column_values_out[column] = coset_values_type(domain->m);
+                            }
+                            if (std::find(columns.begin(), columns.end(), column) == columns.end()) {
+                                columns.push_back(column);
+                            }
+                        }
 
-                                // In parallel version we always resize the assignment poly, it's better for parallelization.
-                                // if (count > 1) {
-                                assignment.resize(extended_domain_size, domain, extended_domain);
-                                variable_values_out[var] = std::move(assignment);
+                        std::vector<typename FieldType::value_type> shift_powers(domain->m);
+                        parallel_for_chunks(domain->m,
+                            [&shift_powers, &shift](std::size_t begin, std::size_t end) {
+                                typename FieldType::value_type power = shift.pow(begin);
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    shift_powers[i] = power;
+                                    power *= shift;
+                                }
                             }, ThreadPool::PoolLevel::HIGH);
+
+                        parallel_for(0, columns.size(),
+                            [&columns, &coefficients, &column_values_out, &shift_powers, &domain](std::size_t i) {
+                                const coefficients_type& column_coefficients = coefficients.at(columns[i]);
+                                coset_values_type& values = column_values_out.at(columns[i]);
+                                if (column_coefficients.size() == 1) {
+                                    std::fill(values.begin(), values.end(), column_coefficients[0]);
+                                    return;
+                                }
+                                for (std::size_t j = 0; j < domain->m; ++j) {
+                                    values[j] = column_coefficients[j] * shift_powers[j];
+                                }
+                                math::fft(domain, values);
+                            }, ThreadPool::PoolLevel::HIGH);
+
+                        // On a coset of H a rotation by 'r' rows is a rotation by 'r' elements of the coset.
+                        variable_values_out.clear();
+                        for (const variable_type& var : variables) {
+                            const variable_type column(var.index, 0, var.relative, var.type);
+                            variable_values_out.emplace(var, coset_view_type(
+                                column_values_out.at(column), var.rotation, domain->m));
+                        }
+                    }
+
+                    /**
+                     * Evaluates a function of the columns read by 'variables' on the extended domain, one coset of
+                     * the original domain H at a time. The extended domain of size k * |H|, with the unity root w,
+                     * is the union of the cosets w^s * H, s < k, and its element w^(j * k + s) is element j of
+                     * coset s. So only |H| values of each column are alive at a time, instead of k * |H|.
+                     *
+                     * 'evaluate_coset(columns, begin, end, out)' writes to out[j] the function of (*columns[i])[j],
+                     * for the rows [begin, end) of a coset, where columns[i] are the values of variables[i].
+                     */
+                    template<typename EvaluateCoset>
+                    static inline polynomial_dfs_type evaluate_by_cosets(
+                        const std::vector<variable_type>& variables,
+                        const std::unordered_map<variable_type, coefficients_type>& coefficients,
+                        std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
+                        std::size_t extended_domain_size,
+                        EvaluateCoset evaluate_coset
+                    ) {
+                        const std::size_t cosets_count = extended_domain_size / original_domain->m;
+                        std::shared_ptr<math::evaluation_domain<FieldType>> extended_domain =
+                            math::get_evaluation_domain<FieldType>(extended_domain_size);
+
+                        std::unordered_map<variable_type, coset_values_type> column_values;
+                        std::unordered_map<variable_type, coset_view_type> variable_values;
+                        std::vector<typename FieldType::value_type> coset_result(original_domain->m);
+
+                        polynomial_dfs_type result(extended_domain_size - 1, extended_domain_size);
+                        for (std::size_t s = 0; s < cosets_count; ++s) {
+                            build_coset_variable_value_map(
+                                variables, coefficients, original_domain, extended_domain->get_domain_element(s),
+                                column_values, variable_values);
+
+                            std::vector<const coset_view_type*> columns;
+                            for (const variable_type& var : variables) {
+                                columns.push_back(&variable_values.at(var));
+                            }
+
+                            parallel_for_chunks(
+                                original_domain->m,
+                                [&evaluate_coset, &columns, &coset_result, &result, cosets_count, s]
+                                (std::size_t begin, std::size_t end) {
+                                    evaluate_coset(columns, begin, end, coset_result);
+                                    for (std::size_t j = begin; j < end; ++j) {
+                                        result[j * cosets_count + s] = coset_result[j];
+                                    }
+                            }, ThreadPool::PoolLevel::HIGH);
+                        }
+                        return result;
                     }
 
                     static inline std::array<polynomial_dfs_type, argument_size> prove_eval(
@@ -144,7 +256,8 @@ namespace nil {
                         std::uint32_t max_gates_degree,
                         const polynomial_dfs_type &mask_polynomial,
                         const polynomial_dfs_type &lagrange_0,
-                        transcript_type& transcript
+                        transcript_type& transcript,
+                        const compiled_gates_evaluator<FieldType>* compiled_evaluator = nullptr
                     ) {
                         PROFILE_SCOPE("gate_argument_time");
 
@@ -153,6 +266,13 @@ namespace nil {
                         ++max_gates_degree;
                         typename FieldType::value_type theta = transcript.template challenge<FieldType>();
 
+                        if (compiled_evaluator != nullptr) {
+                            std::uint32_t max_domain_size =
+                                original_domain->m * std::pow(2, ceil(std::log2(max_gates_degree)));
+                            return {prove_eval_compiled(*compiled_evaluator, column_polynomials, original_domain,
+                                max_domain_size, mask_polynomial, lagrange_0, theta)};
+                        }
+
                         auto value_type_to_polynomial_dfs = [](
                             const typename variable_type::assignment_type& coeff) {
                                 return polynomial_dfs_type(0, 1, coeff);
@@ -207,39 +327,78 @@ namespace nil {
 
                         std::array<polynomial_dfs_type, argument_size> F;
 
+                        // The coefficients of the columns are shared by the expressions, each of them evaluates
+                        // its own cosets from them.
+                        std::vector<math::compiled_expression<variable_type>> programs;
+                        std::vector<variable_type> variables;
+                        for (const auto& expression : expressions) {
+                            programs.emplace_back(expression);
+                            variables.insert(variables.end(),
+                                programs.back().variables().begin(), programs.back().variables().end());
+                        }
+                        std::unordered_map<variable_type, coefficients_type> coefficients;
+                        build_column_coefficients(
+                            variables, column_polynomials, original_domain, mask_polynomial, lagrange_0, coefficients);
+
                         F[0] = polynomial_dfs_type::zero();
                         for (std::size_t i = 0; i < extended_domain_sizes.size(); ++i) {
-                            std::unordered_map<variable_type, polynomial_dfs_type> variable_values;
-
-                            build_variable_value_map(
-                                expressions[i], column_polynomials, original_domain,
-                                extended_domain_sizes[i], variable_values,
-                                mask_polynomial, lagrange_0
-                            );
-
-                            polynomial_dfs_type result(extended_domain_sizes[i] - 1, extended_domain_sizes[i]);
-                            wait_for_all(parallel_run_in_chunks<void>(
-                                extended_domain_sizes[i],
-                                [&variable_values, &extended_domain_sizes, &result, &expressions, i]
-                                (std::size_t begin, std::size_t end) {
-                                    for (std::size_t j = begin; j < end; ++j) {
-                                        // Don't use cache here. In practice it's slower to maintain the cache
-                                        // than to re-compute the subexpression value when value type is field element.
-                                        math::expression_evaluator<variable_type> evaluator(
-                                            expressions[i],
-                                            [&assignments=variable_values, j]
-                                                (const variable_type &var) -> const typename FieldType::value_type& {
-                                                    return assignments[var][j];
-                                            });
-                                        result[j] = evaluator.evaluate();
-                                    }
-                            }, ThreadPool::PoolLevel::HIGH));
-
-                            F[0] += result;
+                            // The expression is compiled once, and the program reads the columns directly.
+                            const math::compiled_expression<variable_type>& program = programs[i];
+                            F[0] += evaluate_by_cosets(
+                                program.variables(), coefficients, original_domain, extended_domain_sizes[i],
+                                [&program](const std::vector<const coset_view_type*>& columns,
+                                           std::size_t begin, std::size_t end,
+                                           std::vector<typename FieldType::value_type>& out) {
+                                    program.evaluate(columns, begin, end, out);
+                                });
                         };
                         return F;
                     }
 
+                    // Evaluates all the gates on the largest extended domain with the evaluator compiled for the
+                    // constraint system, block by block.
+                    static inline polynomial_dfs_type prove_eval_compiled(
+                        const compiled_gates_evaluator<FieldType>& evaluator,
+                        const plonk_polynomial_dfs_table<FieldType> &column_polynomials,
+                        std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
+                        std::size_t extended_domain_size,
+                        const polynomial_dfs_type &mask_polynomial,
+                        const polynomial_dfs_type &lagrange_0,
+                        const typename FieldType::value_type& theta
+                    ) {
+                        using value_type = typename FieldType::value_type;
+
+                        std::vector<value_type> theta_powers(evaluator.constraints_count);
+                        value_type theta_acc = value_type::one();
+                        for (auto& power : theta_powers) {
+                            power = theta_acc;
+                            theta_acc *= theta;
+                        }
+
+                        std::unordered_map<variable_type, coefficients_type> coefficients;
+                        build_column_coefficients(
+                            evaluator.variables, column_polynomials, original_domain, mask_polynomial, lagrange_0,
+                            coefficients);
+
+                        return evaluate_by_cosets(
+                            evaluator.variables, coefficients, original_domain, extended_domain_size,
+                            [&evaluator, &theta_powers](const std::vector<const coset_view_type*>& columns,
+                                                        std::size_t begin, std::size_t end,
+                                                        std::vector<value_type>& out) {
+                                constexpr std::size_t block_size = math::compiled_expression<variable_type>::block_size;
+                                std::vector<value_type> values(columns.size() * block_size);
+                                for (std::size_t start = begin; start < end; start += block_size) {
+                                    const std::size_t rows = std::min(block_size, end - start);
+                                    for (std::size_t i = 0; i < columns.size(); ++i) {
+                                        for (std::size_t r = 0; r < rows; ++r) {
+                                            values[i * rows + r] = (*columns[i])[start + r];
+                                        }
+                                    }
+                                    evaluator.evaluate(values.data(), rows, theta_powers.data(), &out[start]);
+                                }
+                            });
+                    }
+
                     static inline std::array<typename FieldType::value_type, argument_size>
                         verify_eval(const std::vector<plonk_gate<FieldType, plonk_constraint<FieldType>>> &gates,
                                     typename policy_type::evaluation_map &evaluations,
@@ -35,6 +35,10 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
 #include <unordered_map>
 #include <thread>
 
@@ -42,6 +46,8 @@
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+#include <nil/crypto3/math/algorithms/grand_product.hpp>
 
 #include <nil/crypto3/hash/sha2.hpp>
 
@@ -50,6 +56,7 @@
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/grand_product_constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
 
@@ -229,12 +236,13 @@ namespace nil {
                         BOOST_ASSERT(V_L[preprocessed_data.common_data.desc.usable_rows_amount] ==  FieldType::value_type::one());
                         BOOST_ASSERT(std::accumulate(part_sizes.begin(), part_sizes.end(), 0) == sorted.size());
 
-                        // Compute gs and hs products for each part
-                        std::vector<polynomial_dfs_type> gs = compute_gs(
+                        // The factors of the g and h products of each part. The products have the degree of all
+                        // their factors, they are only evaluated coset by coset for F_dfs[2].
+                        std::vector<std::vector<polynomial_dfs_type>> g_factors = compute_g_factors(
                              std::move(lookup_input_ptr), std::move(lookup_value_ptr), beta, gamma, part_sizes
                         );
 
-                        std::vector<polynomial_dfs_type> hs = compute_hs(
+                        std::vector<std::vector<polynomial_dfs_type>> h_factors = compute_h_factors(
                             sorted, beta, gamma, part_sizes
                         );
 
@@ -246,82 +254,42 @@ namespace nil {
                         F_dfs[0] = preprocessed_data.common_data.lagrange_0 * (one_polynomial - V_L);
                         F_dfs[1] = preprocessed_data.q_last * ( V_L * V_L - V_L );
 
-                        // Polynomial g is waaay too large, saving memory here, by making code very unreadable.
-                        //F_dfs[2] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) *
-                        //           (V_L_shifted * h - V_L * g);
-                        F_dfs[2] = zero_polynomial;
-                        if( part_sizes.size() == 1 ){
-                            auto &g = gs[0];
-                            auto &h = hs[0];
-                            g *= V_L;
-                            h *= V_L_shifted;
-                            g -= h;
-                            h = polynomial_dfs_type(); // just clean the memory of h.
-                            g *= (preprocessed_data.q_last + preprocessed_data.q_blind) - one_polynomial;
-                            F_dfs[2] = std::move(g);
-                        } else {
-                            std::vector<polynomial_dfs_type> parts;
-                            BOOST_ASSERT(part_sizes.size() == gs.size());
-                            BOOST_ASSERT(part_sizes.size() == hs.size());
+                        // The partial products V_L = P_0, P_1, ..., P_{i + 1} = P_i * g_i / h_i on the usable rows.
+                        // On the basic domain g_i and h_i are the products of the values of their factors.
+                        std::vector<polynomial_dfs_type> all_polys(1, V_L);
+                        if( part_sizes.size() > 1 ){
                             BOOST_ASSERT(part_sizes.size() == lookup_alphas.size() + 1);
 
-                            std::vector<polynomial_dfs_type> reduced_gs(lookup_alphas.size());
-                            std::vector<polynomial_dfs_type> reduced_hs(lookup_alphas.size());
+                            const std::size_t usable_rows = preprocessed_data.common_data.desc.usable_rows_amount;
+                            std::vector<std::vector<typename FieldType::value_type>> reduced_gs(lookup_alphas.size());
+                            std::vector<std::vector<typename FieldType::value_type>> reduced_hs(lookup_alphas.size());
 
-                            parallel_for(0, lookup_alphas.size(), [this, &gs, &hs, &reduced_gs, &reduced_hs](std::size_t i) {
-                                reduced_gs[i] = reduce_dfs_polynomial_domain(gs[i], basic_domain->m);
-                                reduced_hs[i] = reduce_dfs_polynomial_domain(hs[i], basic_domain->m);
-                            }, ThreadPool::PoolLevel::LOW);
-
-                            // Inverse the values of reduced-hs in-place.
-                            parallel_for(0, lookup_alphas.size(), [&reduced_hs, this](std::size_t i) {
-                                parallel_for(0, this->preprocessed_data.common_data.desc.usable_rows_amount,
-                                    [&reduced_hs, i](std::size_t j) {
-                                        reduced_hs[i][j] = reduced_hs[i][j].inversed();
-                                    },
-                                    ThreadPool::PoolLevel::LOW);
-                                },
-                                ThreadPool::PoolLevel::HIGH);
+                            parallel_for(0, lookup_alphas.size(), [this, &g_factors, &h_factors, &reduced_gs, &reduced_hs, usable_rows](std::size_t i) {
+                                reduced_gs[i] = reduce_dfs_product_domain(g_factors[i], usable_rows);
+                                reduced_hs[i] = reduce_dfs_product_domain(h_factors[i], usable_rows);
+                                // Inverse the values of reduced-hs in-place.
+                                math::batch_inversion(reduced_hs[i].begin(), reduced_hs[i].end());
+                            }, ThreadPool::PoolLevel::HIGH);
 
                             polynomial_dfs_type current_poly = V_L;
-                            polynomial_dfs_type previous_poly = V_L;
-                            // We need to store all the values of current_poly. Suddenly this increases the RAM usage, but
-                            // there's no other way to parallelize this loop.
-                            std::vector<polynomial_dfs_type> all_polys(1, V_L);
-
                             for (std::size_t i = 0; i < lookup_alphas.size(); ++i) {
-
-                                parallel_for(0, preprocessed_data.common_data.desc.usable_rows_amount,
+                                const polynomial_dfs_type& previous_poly = all_polys.back();
+                                parallel_for(0, usable_rows,
                                     [&current_poly, &previous_poly, &reduced_gs, &reduced_hs, i](std::size_t j) {
                                         current_poly[j] = previous_poly[j] * reduced_gs[i][j] * reduced_hs[i][j];
                                     },
                                     ThreadPool::PoolLevel::LOW);
                                 commitment_scheme.append_to_batch(PERMUTATION_BATCH, current_poly);
                                 all_polys.push_back(current_poly);
-                                previous_poly = current_poly;
                             }
-                            std::vector<polynomial_dfs_type> F_dfs_2_parts(
-                                std::thread::hardware_concurrency() + 1,
-                                polynomial_dfs_type::zero());
-                            wait_for_all(parallel_run_in_chunks_with_thread_id<void>(
-                                lookup_alphas.size(),
-                                [&gs, &hs, &lookup_alphas, &all_polys, &F_dfs_2_parts]
-                                (std::size_t thread_id, std::size_t begin, std::size_t end) {
-                                    for (std::size_t i = begin; i < end; ++i) {
-                                        F_dfs_2_parts[thread_id] += (all_polys[i] * gs[i] - all_polys[i + 1] * hs[i]) * lookup_alphas[i];
-                                        // Save a bit or ram by deleting gs[i] and hs[i], we don't need it any more.
-                                        gs[i] = polynomial_dfs_type();
-                                        hs[i] = polynomial_dfs_type();
-                                    }
-                                },
-                                ThreadPool::PoolLevel::HIGH));
-
-                            std::size_t last = lookup_alphas.size();
-                            F_dfs_2_parts.back() = previous_poly * gs[last] - V_L_shifted * hs[last];
-                            F_dfs[2] += polynomial_sum<FieldType>(std::move(F_dfs_2_parts));
-                            F_dfs[2] *= (preprocessed_data.q_last + preprocessed_data.q_blind) - one_polynomial;
                         }
 
+                        //F_dfs[2] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) *
+                        //           (V_L_shifted * h - V_L * g);
+                        F_dfs[2] = detail::grand_product_constraint<FieldType>(
+                            basic_domain, std::move(g_factors), std::move(h_factors), all_polys, V_L_shifted,
+                            lookup_alphas, preprocessed_data.q_last, preprocessed_data.q_blind);
+
                         F_dfs[3] = zero_polynomial;
 
                         std::vector<typename FieldType::value_type> alpha_challenges(sorted.size() - 1);
@@ -346,7 +314,8 @@ namespace nil {
                         };
                     }
 
-                    std::vector<polynomial_dfs_type> compute_gs(
+                    // The factors of the g products, split into the parts.
+                    std::vector<std::vector<polynomial_dfs_type>> compute_g_factors(
                             std::unique_ptr<std::vector<polynomial_dfs_type>> lookup_input_ptr,
                             std::unique_ptr<std::vector<polynomial_dfs_type>> lookup_value_ptr,
                             const typename FieldType::value_type& beta,
@@ -355,7 +324,7 @@ namespace nil {
                     ) {
                         PROFILE_SCOPE("Lookup argument compute_gs");
 
-                        std::vector<polynomial_dfs_type> result(lookup_part_sizes.size());
+                        std::vector<std::vector<polynomial_dfs_type>> result(lookup_part_sizes.size());
                         auto& lookup_value = *lookup_value_ptr;
                         auto& lookup_input = *lookup_input_ptr;
 
@@ -372,28 +341,30 @@ namespace nil {
 
                         parallel_for(0, lookup_part_sizes.size(),
                             [&one, &beta, &part1, &gamma, &lookup_input, &lookup_value, &lookup_part_start_indices, &lookup_part_sizes, &result, this](std::size_t current_part) {
-                                std::vector<polynomial_dfs_type> g_multipliers(
-                                    lookup_part_sizes[current_part]);
+                                std::vector<polynomial_dfs_type>& g_multipliers = result[current_part];
+                                g_multipliers.resize(lookup_part_sizes[current_part]);
 
                                 parallel_for(lookup_part_start_indices[current_part], lookup_part_start_indices[current_part + 1],
                                     [&g_multipliers, &one, &beta, &part1, &gamma, &lookup_input, &lookup_value, &lookup_part_start_indices, &current_part, this](std::size_t i) {
                                     if (i < lookup_input.size()) {
                                         g_multipliers[i - lookup_part_start_indices[current_part]] =
                                             (one + beta) * (gamma + lookup_input[i]);
+                                        lookup_input[i] = polynomial_dfs_type();
                                     } else {
-                                        auto lookup_shifted = math::polynomial_shift(lookup_value[i - lookup_input.size()], 1, this->basic_domain->m);
+                                        auto& value = lookup_value[i - lookup_input.size()];
+                                        auto lookup_shifted = math::polynomial_shift(value, 1, this->basic_domain->m);
                                         g_multipliers[i - lookup_part_start_indices[current_part]] =
-                                            part1 + lookup_value[i - lookup_input.size()] + beta * lookup_shifted;
+                                            part1 + value + beta * lookup_shifted;
+                                        value = polynomial_dfs_type();
                                     }
                                 }, ThreadPool::PoolLevel::HIGH);
-                                result[current_part] = math::polynomial_product<FieldType>(std::move(g_multipliers));
-
                             }, ThreadPool::PoolLevel::LASTPOOL);
 
-                        return std::move(result);
+                        return result;
                     }
 
-                    std::vector<polynomial_dfs_type> compute_hs(
+                    // The factors of the h products, split into the parts.
+                    std::vector<std::vector<polynomial_dfs_type>> compute_h_factors(
                             const std::vector<polynomial_dfs_type>& sorted,
                             const typename FieldType::value_type& beta,
                             const typename FieldType::value_type& gamma,
@@ -403,7 +374,7 @@ namespace nil {
 
                         auto one = FieldType::value_type::one();
 
-                        std::vector<polynomial_dfs_type> result(lookup_part_sizes.size());
+                        std::vector<std::vector<polynomial_dfs_type>> result(lookup_part_sizes.size());
 
                         // Precompute the indices of start and end locations for each chunk.
                         std::vector<std::size_t> lookup_part_start_indices;
@@ -414,7 +385,8 @@ namespace nil {
 
                         parallel_for(0, lookup_part_sizes.size(),
                             [ &sorted, &one, &beta, &gamma, &lookup_part_start_indices, &lookup_part_sizes, &result, this](std::size_t current_part) {
-                                std::vector<polynomial_dfs_type> h_multipliers(lookup_part_sizes[current_part]);
+                                std::vector<polynomial_dfs_type>& h_multipliers = result[current_part];
+                                h_multipliers.resize(lookup_part_sizes[current_part]);
 
                                 parallel_for(lookup_part_start_indices[current_part], lookup_part_start_indices[current_part + 1],
                                     [&sorted, &h_multipliers, &one, &beta, &gamma, &lookup_part_start_indices, &current_part, this](std::size_t i) {
@@ -423,11 +395,9 @@ namespace nil {
                                         (one + beta) * gamma + sorted[i] + beta * sorted_shifted;
 
                                 }, ThreadPool::PoolLevel::HIGH);
-                                result[current_part] = math::polynomial_product<FieldType>(std::move(h_multipliers));
-
                             }, ThreadPool::PoolLevel::LASTPOOL);
 
-                        return std::move(result);
+                        return result;
                     }
 
                     polynomial_dfs_type compute_V_L(
@@ -443,8 +413,12 @@ namespace nil {
                         V_L[0] = FieldType::value_type::one();
                         auto one = FieldType::value_type::one();
 
+                        // V_L[k] = V_L[k-1] * g(k-1) / h(k-1). The numerators are written to V_L, the denominators are
+                        // inverted all at once.
+                        std::vector<typename FieldType::value_type> denominators(
+                            preprocessed_data.common_data.desc.usable_rows_amount + 1, one);
                         parallel_for(1, preprocessed_data.common_data.desc.usable_rows_amount + 1,
-                                [&one, &beta, &V_L, &reduced_input, &reduced_value, &sorted, &gamma](std::size_t k) {
+                                [&one, &beta, &V_L, &denominators, &reduced_input, &reduced_value, &sorted, &gamma](std::size_t k) {
                             typename FieldType::value_type g_tmp = (one + beta).pow(reduced_input.size());
                             for (std::size_t i = 0; i < reduced_input.size(); i++) {
                                 g_tmp *= gamma + reduced_input[i][k-1];
@@ -461,13 +435,12 @@ namespace nil {
                             for (std::size_t i = 0; i < sorted.size(); i++) {
                                 h_tmp *= part1 + sorted[i][k-1] + beta * sorted[i][k];
                             }
-                            V_L[k] *= h_tmp.inversed();
+                            denominators[k] = h_tmp;
                         }, ThreadPool::PoolLevel::HIGH);
 
-                        // TODO(martun): we can parallize the lower loop as well, but it's fast enough to ignore for now.
-                        for (std::size_t k = 1; k <= preprocessed_data.common_data.desc.usable_rows_amount; k++) {
-                            V_L[k] *= V_L[k-1];
-                        }
+                        math::grand_product(
+                            V_L.begin(), V_L.begin() + preprocessed_data.common_data.desc.usable_rows_amount + 1,
+                            denominators.begin(), V_L.begin());
 
                         return V_L;
                     }
@@ -543,7 +516,10 @@ namespace nil {
                                     math::expression_variable_type_converter<VariableType, DfsVariableType> converter(value_type_to_polynomial_dfs);
 
                                     const auto& constraint = gate.constraints[index];
-                                    polynomial_dfs_type l = lookup_selector * (typename FieldType::value_type(constraint.table_id));
+                                    // l = lookup_selector * (table_id + theta * input_0 + theta^2 * input_1 + ...),
+                                    // the sum is accumulated first, so the selector is multiplied in only once.
+                                    polynomial_dfs_type l(0, lookup_selector.size(),
+                                        typename FieldType::value_type(constraint.table_id));
 
                                     typename FieldType::value_type theta_acc = this->theta;
                                     for(std::size_t k = 0; k < constraint.lookup_input.size(); k++){
@@ -571,9 +547,19 @@ namespace nil {
                                             }
                                         );
 
-                                        l += theta_acc * lookup_selector * evaluator.evaluate();
+                                        polynomial_dfs_type input = evaluator.evaluate();
+                                        if (input.size() == l.size()) {
+                                            l.fused_apply(std::max(l.degree(), input.degree()),
+                                                [&theta_acc](typename FieldType::value_type& a,
+                                                             const typename FieldType::value_type& b) {
+                                                    a += theta_acc * b;
+                                                }, input);
+                                        } else {
+                                            l += theta_acc * input;
+                                        }
                                         theta_acc *= this->theta;
                                     }
+                                    l *= lookup_selector;
                                     (*lookup_input_ptr)[lookup_inputs_used + index] = l;
                                 }, ThreadPool::PoolLevel::HIGH);
                         }
@@ -604,6 +590,22 @@ namespace nil {
                         return reduced;
                     };
 
+                    // Values of the product of 'factors' on the first 'rows' rows of the basic domain.
+                    std::vector<typename FieldType::value_type> reduce_dfs_product_domain(
+                        const std::vector<polynomial_dfs_type> &factors,
+                        std::size_t rows
+                    ) {
+                        std::vector<typename FieldType::value_type> reduced(rows, FieldType::value_type::one());
+                        for (const auto &factor : factors) {
+                            BOOST_ASSERT(factor.size() % basic_domain->m == 0);
+                            const std::size_t step = factor.size() / basic_domain->m;
+                            parallel_for(0, rows, [&reduced, &factor, step](std::size_t j) {
+                                reduced[j] *= factor[j * step];
+                            }, ThreadPool::PoolLevel::LOW);
+                        }
+                        return reduced;
+                    }
+
                     polynomial_dfs_type get_constraint_tag_from_gate_tag_column(
                         polynomial_dfs_type tag_column,
                         std::size_t constraints_num,
@@ -657,20 +659,52 @@ namespace nil {
                     ) {
                         PROFILE_SCOPE("Sort Polynomials");
 
-                        //  Build sorting map
-                        std::unordered_map<typename FieldType::value_type, std::size_t> sorting_map;
-                        for (std::size_t i = 0; i < reduced_value.size(); i++) {
-                            for (std::size_t j = 0; j < usable_rows_amount; j++) {
-                                sorting_map[reduced_value[i][j]] = 1;
-                            }
-                        }
+                        typedef typename FieldType::value_type value_type;
+
+                        // Sorted list of the distinct table values, with the position of the first occurrence of each.
+                        std::size_t table_size = reduced_value.size() * usable_rows_amount;
+                        std::vector<std::pair<value_type, std::size_t>> table_index(table_size);
+                        parallel_for(0, table_size, [&table_index, &reduced_value, usable_rows_amount](std::size_t k) {
+                            table_index[k] = {reduced_value[k / usable_rows_amount][k % usable_rows_amount], k};
+                        }, ThreadPool::PoolLevel::LOW);
+                        parallel_sort(table_index.begin(), table_index.end(), ThreadPool::PoolLevel::LOW);
+                        table_index.erase(
+                            std::unique(table_index.begin(), table_index.end(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; }),
+                            table_index.end());
+
+                        // How many times each of the distinct table values is used in the inputs.
+                        std::vector<std::atomic<std::size_t>> input_counts(table_index.size());
+                        parallel_for(0, reduced_input.size() * usable_rows_amount,
+                            [&table_index, &input_counts, &reduced_input, usable_rows_amount](std::size_t k) {
+                                const value_type& input = reduced_input[k / usable_rows_amount][k % usable_rows_amount];
+                                auto it = std::lower_bound(table_index.begin(), table_index.end(), input,
+                                    [](const std::pair<value_type, std::size_t>& entry, const value_type& value) {
+                                        return entry.first < value;
+                                    });
+                                // Every input value must be in the set of values of reduced_value.
+                                if (it == table_index.end() || it->first != input) {
+                                    throw std::invalid_argument("lookup input not in table");
+                                }
+                                input_counts[it - table_index.begin()].fetch_add(1, std::memory_order_relaxed);
+                            }, ThreadPool::PoolLevel::LOW);
 
-                        for (std::size_t i = 0; i < reduced_input.size(); i++) {
-                            for (std::size_t j = 0; j < usable_rows_amount; j++) {
-                                // This assert means that every value \in keys of sorting_map = set of values of reduced_value
-                                BOOST_ASSERT(sorting_map.find(reduced_input[i][j]) != sorting_map.end());
-                                sorting_map[reduced_input[i][j]]++;
-                            }
+                        // Inputs equal to a table value are placed right after the first occurrence of that value.
+                        // So the table value k of reduced_value takes 1 + (its copies) rows of the sorted columns,
+                        // ending at row ends[k], counting the rows of all the columns one after another.
+                        std::vector<std::size_t> ends(table_size, 1);
+                        parallel_for(0, table_index.size(), [&table_index, &input_counts, &ends](std::size_t i) {
+                            ends[table_index[i].second] += input_counts[i].load(std::memory_order_relaxed);
+                        }, ThreadPool::PoolLevel::LOW);
+                        table_index.clear();
+                        table_index.shrink_to_fit();
+                        parallel_inclusive_scan(ends.begin(), ends.end(), ends.begin(), std::plus<std::size_t>(),
+                            ThreadPool::PoolLevel::LOW);
+
+                        // The scatter below writes rows [0, ends.back()) of the sorted columns without further checks.
+                        const std::size_t sorted_rows = (reduced_input.size() + reduced_value.size()) * usable_rows_amount;
+                        if (table_size != 0 && ends.back() != sorted_rows) {
+                            throw std::logic_error("sorted lookup values do not fill the sorted columns");
                         }
 
                         polynomial_dfs_type zero_poly(
@@ -678,27 +712,14 @@ namespace nil {
                         std::vector<polynomial_dfs_type> sorted(
                             reduced_input.size() + reduced_value.size(), zero_poly
                         );
-                        std::size_t i1 = 0;
-                        std::size_t j1 = 0;
-                        auto append_to_sorted = [usable_rows_amount, &sorted, &i1, &j1] (
-                                const typename FieldType::value_type& value) {
-                            sorted[i1][j1] = value;
-                            j1++;
-                            if (j1 >= usable_rows_amount){
-                                i1++; j1 = 0;
-                            }
-                        };
 
-                        for (std::size_t i = 0; i < reduced_value.size(); i++) {
-                            for (std::size_t j = 0; j < usable_rows_amount; j++) {
-                                typename FieldType::value_type val = reduced_value[i][j];
-                                for (std::size_t k = 0; k < sorting_map[val]; k++) {
-                                    BOOST_ASSERT(j1 < usable_rows_amount);
-                                    append_to_sorted(val);
-                                }
-                                sorting_map[val] = 1;
+                        // Each table value fills its own rows, so all of them are written in parallel.
+                        parallel_for(0, table_size, [&reduced_value, &ends, &sorted, usable_rows_amount](std::size_t k) {
+                            const value_type& val = reduced_value[k / usable_rows_amount][k % usable_rows_amount];
+                            for (std::size_t row = (k == 0 ? 0 : ends[k - 1]); row < ends[k]; row++) {
+                                sorted[row / usable_rows_amount][row % usable_rows_amount] = val;
                             }
-                        }
+                        }, ThreadPool::PoolLevel::LOW);
 
                         for (std::size_t i = 0; i < sorted.size() - 1; i++) {
                             sorted[i][usable_rows_amount] = sorted[i+1][0];
@@ -32,12 +32,15 @@
 #endif
 
 #include <algorithm>
+#include <functional>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+#include <nil/crypto3/math/algorithms/grand_product.hpp>
 
 #include <nil/crypto3/hash/sha2.hpp>
 
@@ -45,6 +48,7 @@
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/grand_product_constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
@@ -119,63 +123,54 @@ namespace nil {
                             BOOST_ASSERT(S_id[i].size() == basic_domain->size());
                             BOOST_ASSERT(S_sigma[i].size() == basic_domain->size());
 
+                            const auto& column = column_polynomials[global_indices[i]];
+                            auto combine = [&beta, &gamma](
+                                    typename FieldType::value_type& s, const typename FieldType::value_type& c) {
+                                s = s * beta + gamma + c;
+                            };
+
                             /* g_v.push_back(column_polynomials[i] + beta * S_id[i] + gamma); */
-                            g_v[i] *= beta;
-                            g_v[i] += gamma;
-                            g_v[i] += column_polynomials[global_indices[i]];
+                            g_v[i].fused_apply(std::max(g_v[i].degree(), column.degree()), combine, column);
 
                             /* h_v.push_back(column_polynomials[i] + beta * S_sigma[i] + gamma); */
-                            h_v[i] *= beta;
-                            h_v[i] += gamma;
-                            h_v[i] += column_polynomials[global_indices[i]];
+                            h_v[i].fused_apply(std::max(h_v[i].degree(), column.degree()), combine, column);
                         }, ThreadPool::PoolLevel::HIGH);
 
-                        V_P[0] = FieldType::value_type::one();
-
-                        auto V_P_parts = std::make_unique<std::vector<typename FieldType::value_type>>(
-                            basic_domain->size(), FieldType::value_type::zero());
-                        parallel_for(1, basic_domain->size(), [&g_v, &h_v, &S_id, &V_P_parts](std::size_t j) {
-                            typename FieldType::value_type nom = FieldType::value_type::one();
-                            typename FieldType::value_type denom = FieldType::value_type::one();
-
-                            for (std::size_t i = 0; i < S_id.size(); i++) {
-                                nom *= g_v[i][j - 1];
-                                denom *= h_v[i][j - 1];
-                            }
-                            (*V_P_parts)[j] = nom * denom.inversed();
-                        }, ThreadPool::PoolLevel::LOW);
-
-                        for (std::size_t j = 1; j < basic_domain->size(); ++j)
-                            V_P[j] = V_P[j - 1] * (*V_P_parts)[j];
-                        V_P_parts.reset(nullptr);
+                        // V_P[j] = V_P[j - 1] * nom(j - 1) / denom(j - 1), the first parts stay one, so that V_P[0] = 1.
+                        {
+                            std::vector<typename FieldType::value_type> noms(
+                                basic_domain->size(), FieldType::value_type::one());
+                            std::vector<typename FieldType::value_type> denoms(
+                                basic_domain->size(), FieldType::value_type::one());
+                            parallel_for(1, basic_domain->size(), [&g_v, &h_v, &S_id, &noms, &denoms](std::size_t j) {
+                                for (std::size_t i = 0; i < S_id.size(); i++) {
+                                    noms[j] *= g_v[i][j - 1];
+                                    denoms[j] *= h_v[i][j - 1];
+                                }
+                            }, ThreadPool::PoolLevel::LOW);
+
+                            math::grand_product(noms.begin(), noms.end(), denoms.begin(), V_P.begin());
+                        }
 
                         // 4. Compute and add commitment to $V_P$ to $\text{transcript}$.
                         // TODO: Better enumeration for polynomial batches
                         commitment_scheme.append_to_batch(PERMUTATION_BATCH, V_P);
 
-                        // 5. Calculate g_perm, h_perm
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> gs;
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> hs;
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> g_factors;
-                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> h_factors;
+                        // 5. Split the factors into the parts of g_perm, h_perm. The products of the parts have the
+                        // degree of all their factors, they are only evaluated coset by coset for F_dfs[1].
+                        std::vector<std::vector<math::polynomial_dfs<typename FieldType::value_type>>> g_parts;
+                        std::vector<std::vector<math::polynomial_dfs<typename FieldType::value_type>>> h_parts;
                         for(std::size_t i = 0; i < g_v.size(); i++){
-                            g_factors.push_back(g_v[i]);
-                            h_factors.push_back(h_v[i]);
-                            if( preprocessed_data.common_data.max_quotient_chunks != 0 && g_factors.size() == (preprocessed_data.common_data.max_quotient_chunks - 1)) {
-                                gs.push_back(math::polynomial_product<FieldType>(g_factors));
-                                hs.push_back(math::polynomial_product<FieldType>(h_factors));
-                                g_factors.clear();
-                                h_factors.clear();
+                            if( g_parts.empty() || (preprocessed_data.common_data.max_quotient_chunks != 0 &&
+                                    g_parts.back().size() == (preprocessed_data.common_data.max_quotient_chunks - 1)) ){
+                                g_parts.emplace_back();
+                                h_parts.emplace_back();
                             }
+                            g_parts.back().push_back(std::move(g_v[i]));
+                            h_parts.back().push_back(std::move(h_v[i]));
                         }
-                        if( g_factors.size() != 0 ){
-                            gs.push_back(math::polynomial_product<FieldType>(g_factors));
-                            hs.push_back(math::polynomial_product<FieldType>(h_factors));
-                            g_factors.clear();
-                            h_factors.clear();
-                        }
-                        BOOST_ASSERT(gs.size() == preprocessed_data.common_data.permutation_parts);
-                        BOOST_ASSERT(gs.size() == hs.size());
+                        BOOST_ASSERT(g_parts.size() == preprocessed_data.common_data.permutation_parts);
+                        BOOST_ASSERT(g_parts.size() == h_parts.size());
 
                         math::polynomial_dfs<typename FieldType::value_type> one_polynomial(
                             0, V_P.size(), FieldType::value_type::one());
@@ -193,61 +188,47 @@ namespace nil {
                             permutation_alphas.push_back(transcript.template challenge<FieldType>());
                         }
 
-                        /* F_dfs[1] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) * (V_P_shifted * h - V_P * g); */
-                        if ( preprocessed_data.common_data.permutation_parts == 1 ){
-                            auto &g = gs[0];
-                            auto &h = hs[0];
-                            math::polynomial_dfs<typename FieldType::value_type> t1 = V_P;
-                            t1 *= g;
-                            V_P_shifted *= h;
-                            V_P_shifted -= t1;
-
-                            F_dfs[1] = one_polynomial;
-                            F_dfs[1] -= preprocessed_data.q_last;
-                            F_dfs[1] -= preprocessed_data.q_blind;
-                            F_dfs[1] *= V_P_shifted;
-                        } else {
+                        // The partial products V_P = P_0, P_1, ..., P_{i + 1} = P_i * g_i / h_i on the usable rows.
+                        // On the basic domain g_i and h_i are the products of the values of their factors.
+                        std::vector<math::polynomial_dfs<typename FieldType::value_type>> all_polys(1, V_P);
+                        if ( preprocessed_data.common_data.permutation_parts > 1 ) {
                             PROFILE_SCOPE("PERMUTATION ARGUMENT else block");
-                            math::polynomial_dfs<typename FieldType::value_type> previous_poly = V_P;
+                            const std::size_t usable_rows = preprocessed_data.common_data.desc.usable_rows_amount;
                             math::polynomial_dfs<typename FieldType::value_type> current_poly = V_P;
-                            // We need to store all the values of current_poly. Suddenly this increases the RAM usage, but 
-                            // there's no other way to parallelize this loop.
-                            std::vector<math::polynomial_dfs<typename FieldType::value_type>> all_polys(1, V_P);
+                            std::vector<typename FieldType::value_type> reduced_g(usable_rows);
+                            std::vector<typename FieldType::value_type> reduced_h(usable_rows);
 
                             for( std::size_t i = 0; i < preprocessed_data.common_data.permutation_parts-1; i++ ){
-                                const auto& g = gs[i];
-                                const auto& h = hs[i];
-                                auto reduced_g = reduce_dfs_polynomial_domain(g, basic_domain->m);
-                                auto reduced_h = reduce_dfs_polynomial_domain(h, basic_domain->m);
+                                const auto& g_factors = g_parts[i];
+                                const auto& h_factors = h_parts[i];
+                                parallel_for(0, usable_rows,
+                                    [&g_factors, &h_factors, &reduced_g, &reduced_h](std::size_t j) {
+                                        reduced_g[j] = reduced_h[j] = FieldType::value_type::one();
+                                        for (std::size_t k = 0; k < g_factors.size(); k++) {
+                                            reduced_g[j] *= g_factors[k][j];
+                                            reduced_h[j] *= h_factors[k][j];
+                                        }
+                                    },
+                                    ThreadPool::PoolLevel::LOW);
 
-                                parallel_for(0, preprocessed_data.common_data.desc.usable_rows_amount,
+                                math::batch_inversion(reduced_h.begin(), reduced_h.end());
+                                const auto& previous_poly = all_polys.back();
+                                parallel_for(0, usable_rows,
                                     [&reduced_g, &reduced_h, &current_poly, &previous_poly](std::size_t j) {
-                                        current_poly[j] = (previous_poly[j] * reduced_g[j]) * reduced_h[j].inversed();
+                                        current_poly[j] = (previous_poly[j] * reduced_g[j]) * reduced_h[j];
                                     },
                                     ThreadPool::PoolLevel::LOW);
 
                                 commitment_scheme.append_to_batch(PERMUTATION_BATCH, current_poly);
                                 all_polys.push_back(current_poly);
-                                previous_poly = current_poly;
                             }
-                            std::vector<math::polynomial_dfs<typename FieldType::value_type>> F_dfs_1_parts(
-                                preprocessed_data.common_data.permutation_parts);
-                            parallel_for(0, preprocessed_data.common_data.permutation_parts - 1,
-                                [&gs, &hs, &permutation_alphas, &all_polys, &F_dfs_1_parts](std::size_t i) {
-                                    auto &g = gs[i];
-                                    auto &h = hs[i];
-                                    F_dfs_1_parts[i] = permutation_alphas[i] * (all_polys[i] * g - all_polys[i + 1] * h);
-                                },
-                                ThreadPool::PoolLevel::HIGH);
-
-                            std::size_t last = permutation_alphas.size();
-                            auto &g = gs[last];
-                            auto &h = hs[last];
-                            F_dfs_1_parts.back() = previous_poly * g - V_P_shifted * h;
-                            F_dfs[1] += polynomial_sum<FieldType>(std::move(F_dfs_1_parts));
-                            F_dfs[1] *= (preprocessed_data.q_last + preprocessed_data.q_blind) - one_polynomial;
                         }
 
+                        /* F_dfs[1] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) * (V_P_shifted * h - V_P * g); */
+                        F_dfs[1] = detail::grand_product_constraint<FieldType>(
+                            basic_domain, std::move(g_parts), std::move(h_parts), all_polys, V_P_shifted,
+                            permutation_alphas, preprocessed_data.q_last, preprocessed_data.q_blind);
+
                         /* F_dfs[2] = preprocessed_data.q_last * V_P * (V_P - one_polynomial); */
                         F_dfs[2] = V_P;
                         F_dfs[2] -= one_polynomial;
@@ -366,27 +347,6 @@ namespace nil {
 
                         return F;
                     }
-
-                    static math::polynomial_dfs<typename FieldType::value_type> reduce_dfs_polynomial_domain(
-                        const math::polynomial_dfs<typename FieldType::value_type> &polynomial,
-                        const std::size_t &new_domain_size
-                    ) {
-                        math::polynomial_dfs<typename FieldType::value_type> reduced(
-                            new_domain_size - 1, new_domain_size, FieldType::value_type::zero());
-
-                        BOOST_ASSERT(new_domain_size <= polynomial.size());
-                        if (polynomial.size() == new_domain_size) {
-                            reduced = polynomial;
-                        } else {
-                            BOOST_ASSERT(polynomial.size() % new_domain_size == 0);
-
-                            std::size_t step = polynomial.size() / new_domain_size;
-                            for (std::size_t i = 0; i < new_domain_size; i++) {
-                                reduced[i] = polynomial[i * step];
-                            }
-                        }
-                        return reduced;
-                    };
                 };
             }    // namespace snark
         }        // namespace zk
@@ -241,7 +241,7 @@ namespace nil {
                                 // lagrange_0:  1, 0,...,0
                                 lagrange_0[0] = FieldType::value_type::one();
 
-                                basic_domain = math::make_evaluation_domain<FieldType>(table_description.rows_amount);
+                                basic_domain = math::get_evaluation_domain<FieldType>(table_description.rows_amount);
                             }
 
                             // These operators are useful for marshalling
@@ -588,7 +588,7 @@ namespace nil {
                         assert(max_gates_degree > 0);
 
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
-                            math::make_evaluation_domain<FieldType>(N_rows);
+                            math::get_evaluation_domain<FieldType>(N_rows);
 
                         auto permuted_columns = constraint_system.permuted_columns();
                         std::vector<std::size_t> global_indices;
@@ -693,7 +693,7 @@ namespace nil {
                         std::size_t N_rows = table_description.rows_amount;
 
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
-                            math::make_evaluation_domain<FieldType>(N_rows);
+                            math::get_evaluation_domain<FieldType>(N_rows);
 
                         auto private_polynomial_table = std::make_shared<plonk_private_polynomial_dfs_table<FieldType>>(
                             detail::column_range_polynomial_dfs<FieldType>(
@@ -195,7 +195,10 @@ namespace nil {
                             preprocessed_public_data.common_data.max_gates_degree,
                             mask_polynomial,
                             preprocessed_public_data.common_data.lagrange_0,
-                            transcript
+                            transcript,
+                            compiled_gates_evaluators<FieldType>::instance().find(
+                                compiled_gates_evaluators<FieldType>::key(
+                                    preprocessed_public_data.common_data.vk.constraint_system_with_params_hash))
                         )[0];
 
                         _polynomial_table.reset(); // We don't need it anymore, release memory
@@ -243,11 +246,6 @@ namespace nil {
                     std::vector<polynomial_dfs_type> quotient_polynomial_split_dfs() {
                         PROFILE_SCOPE("quotient_polynomial_split_dfs");
 
-                        // TODO: pass max_degree parameter placeholder
-                        std::vector<polynomial_type> T_splitted = detail::split_polynomial<FieldType>(
-                            quotient_polynomial(), table_description.rows_amount - 1
-                        );
-
                         std::size_t split_polynomial_size = std::max(
                             (preprocessed_public_data.identity_polynomials.size() + 2) * (preprocessed_public_data.common_data.desc.rows_amount -1 ),
                             (constraint_system.lookup_poly_degree_bound() + 1) * (preprocessed_public_data.common_data.desc.rows_amount -1 )//,
@@ -272,19 +270,22 @@ namespace nil {
                         //      F[7] (from gates argument)
                         // If some columns used in permutation or lookup argument are zero, real quotient polynomial degree
                         //      may be less than split_polynomial_size.
-                        std::vector<polynomial_dfs_type> T_splitted_dfs(T_splitted.size());
-
-                        parallel_for(0, T_splitted.size(), [&T_splitted, &T_splitted_dfs](std::size_t k) {
-                            T_splitted_dfs[k].from_coefficients(T_splitted[k]);
-                        }, ThreadPool::PoolLevel::HIGH);
-
                         // DO NOT CHANGE, sizes are different by design
+                        std::vector<polynomial_dfs_type> T_splitted_dfs = quotient_polynomial_chunks_dfs(split_polynomial_size);
                         T_splitted_dfs.resize(split_polynomial_size);
 
                         return T_splitted_dfs;
                     }
 
-                    polynomial_type quotient_polynomial() {
+                    // Returns the quotient T = F_consolidated / Z split into chunks of rows_amount coefficients, in
+                    // evaluation form on the basic domain.
+                    //
+                    // Z = x^n - 1, n = rows_amount, so the coefficient i of T is the sum of the coefficients i + m * n,
+                    // m >= 1, of F_consolidated. With F_m being the chunk m of the coefficients of F_consolidated, the
+                    // chunk j of T is F_{j + 1} + ... + F_{k - 1}. The chunks are accumulated right to left and moved to
+                    // evaluation form with one batched FFT on the basic domain, T is never built in coefficient form.
+                    // Only the first 'max_chunks' chunks are returned.
+                    std::vector<polynomial_dfs_type> quotient_polynomial_chunks_dfs(std::size_t max_chunks) {
                         PROFILE_SCOPE("quotient_polynomial_time");
 
                         // 7.1. Get $\alpha_0, \dots, \alpha_8 \in \mathbb{F}$ from $hash(\text{transcript})$
@@ -304,12 +305,40 @@ namespace nil {
 
                         polynomial_dfs_type F_consolidated_dfs = polynomial_sum<FieldType>(std::move(F_consolidated_dfs_parts));
 
-                        polynomial_type F_consolidated_normal(F_consolidated_dfs.coefficients());
+                        // 7.3. Divide by Z and split
+                        const std::size_t n = table_description.rows_amount;
+                        BOOST_ASSERT(preprocessed_public_data.common_data.Z.size() == n + 1);
+                        BOOST_ASSERT(preprocessed_public_data.common_data.basic_domain->size() == n);
+
+                        // 'coefficients' drops the leading zeros, T has ceil((F_coefficients.size() - n) / n) chunks.
+                        std::vector<typename FieldType::value_type> F_coefficients = F_consolidated_dfs.coefficients();
+                        const std::size_t chunks_count = F_coefficients.size() > n ? (F_coefficients.size() - 1) / n : 0;
+                        F_coefficients.resize((chunks_count + 1) * n, FieldType::value_type::zero());
+
+                        std::vector<std::vector<typename FieldType::value_type>> T_chunks(std::min(chunks_count, max_chunks),
+                            std::vector<typename FieldType::value_type>(n));
+                        parallel_for_chunks(n, [&F_coefficients, &T_chunks, chunks_count, n](std::size_t begin, std::size_t end) {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                typename FieldType::value_type sum = FieldType::value_type::zero();
+                                for (std::size_t j = chunks_count; j-- > 0;) {
+                                    sum += F_coefficients[(j + 1) * n + i];
+                                    if (j < T_chunks.size()) {
+                                        T_chunks[j][i] = sum;
+                                    }
+                                }
+                            }
+                        }, ThreadPool::PoolLevel::HIGH);
+                        F_coefficients.clear();
+                        F_coefficients.shrink_to_fit();
 
-                        polynomial_type T_consolidated =
-                            F_consolidated_normal / preprocessed_public_data.common_data.Z;
+                        preprocessed_public_data.common_data.basic_domain->fft_batch(T_chunks);
 
-                        return T_consolidated;
+                        std::vector<polynomial_dfs_type> T_splitted_dfs;
+                        T_splitted_dfs.reserve(chunks_count);
+                        for (auto& chunk : T_chunks) {
+                            T_splitted_dfs.emplace_back(n - 1, std::move(chunk));
+                        }
+                        return T_splitted_dfs;
                     }
 
                     typename placeholder_lookup_argument_prover<FieldType, commitment_scheme_type, ParamsType>::prover_lookup_result
@@ -459,6 +459,88 @@ BOOST_AUTO_TEST_SUITE(lpc_math_polynomial_suite);
         BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
     }
 
+    BOOST_FIXTURE_TEST_CASE(lpc_dfs_batch_in_files_test, test_fixture) {
+        // Setup types
+        typedef algebra::curves::bls12<381> curve_type;
+        typedef typename curve_type::scalar_field_type FieldType;
+        typedef typename FieldType::value_type value_type;
+
+        typedef hashes::sha2<256> merkle_hash_type;
+        typedef hashes::sha2<256> transcript_hash_type;
+
+        constexpr static const std::size_t lambda = 10;
+        constexpr static const std::size_t m = 2;
+
+        // The polynomials must be large enough for mapped_file_allocator to put them in files.
+        constexpr static const std::size_t d = 1 << 16;
+        static_assert(d * sizeof(value_type) >= mapped_file_allocator<value_type>::min_mapped_bytes);
+
+        typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, m> fri_type;
+
+        typedef zk::commitments::
+        list_polynomial_commitment_params<merkle_hash_type, transcript_hash_type, m>
+                lpc_params_type;
+        typedef zk::commitments::list_polynomial_commitment<FieldType, lpc_params_type> lpc_type;
+
+        // Setup params
+        std::size_t degree_log = std::ceil(std::log2(d - 1));
+        typename fri_type::params_type fri_params(
+                1, /*max_step*/
+                degree_log,
+                lambda,
+                2, //expand_factor
+                false // use_grinding, its nonce is random and the proofs are compared
+                );
+
+        using lpc_scheme_type = nil::crypto3::zk::commitments::lpc_commitment_scheme<lpc_type>;
+        lpc_scheme_type lpc_scheme_in_files(fri_params);
+        lpc_scheme_type lpc_scheme_in_memory(fri_params);
+        lpc_scheme_type lpc_scheme_verifier(fri_params);
+
+        auto batch_0 = generate_random_polynomial_dfs_batch<FieldType>(2, d, test_global_alg_rnd_engine<FieldType>);
+        auto batch_1 = generate_random_polynomial_dfs_batch<FieldType>(2, d, test_global_alg_rnd_engine<FieldType>);
+        lpc_scheme_in_files.append_to_batch(0, batch_0);
+        lpc_scheme_in_files.append_to_batch(1, batch_1);
+        lpc_scheme_in_memory.append_to_batch(0, batch_0);
+        lpc_scheme_in_memory.append_to_batch(1, batch_1);
+
+        lpc_scheme_in_files.store_batch_in_files(1);
+
+        std::size_t peak_mapped_bytes = mapped_file_storage::instance().get_peak_mapped_bytes();
+        std::map<std::size_t, typename lpc_type::commitment_type> commitments;
+        commitments[0] = lpc_scheme_in_files.commit(0);
+        commitments[1] = lpc_scheme_in_files.commit(1);
+        // The extended batch was in the files, and they are all released after the commitment.
+        BOOST_CHECK(mapped_file_storage::instance().get_peak_mapped_bytes() > peak_mapped_bytes);
+        BOOST_CHECK_EQUAL(mapped_file_storage::instance().get_mapped_bytes(), 0);
+
+        // The commitment does not depend on where the extended polynomials are stored.
+        BOOST_CHECK(commitments[0] == lpc_scheme_in_memory.commit(0));
+        BOOST_CHECK(commitments[1] == lpc_scheme_in_memory.commit(1));
+
+        auto point = algebra::fields::arithmetic_params<FieldType>::multiplicative_generator;
+        lpc_scheme_in_files.append_eval_point(0, point);
+        lpc_scheme_in_files.append_eval_point(1, point);
+        lpc_scheme_in_memory.append_eval_point(0, point);
+        lpc_scheme_in_memory.append_eval_point(1, point);
+
+        std::array<std::uint8_t, 96> x_data{};
+
+        // Prove, the batch read back from the files gives the same proof.
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_in_files(x_data);
+        auto proof = lpc_scheme_in_files.proof_eval(transcript_in_files);
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_in_memory(x_data);
+        BOOST_CHECK(proof == lpc_scheme_in_memory.proof_eval(transcript_in_memory));
+
+        // Verify
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_verifier(x_data);
+        lpc_scheme_verifier.set_batch_size(0, proof.z.get_batch_size(0));
+        lpc_scheme_verifier.set_batch_size(1, proof.z.get_batch_size(1));
+        lpc_scheme_verifier.append_eval_point(0, point);
+        lpc_scheme_verifier.append_eval_point(1, point);
+        BOOST_CHECK(lpc_scheme_verifier.verify_eval(proof, commitments, transcript_verifier));
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(lpc_params_test_suite)
@@ -39,6 +39,7 @@
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
+#include <nil/crypto3/zk/math/compiled_expression.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 
 using namespace nil::crypto3;
@@ -158,4 +159,61 @@ BOOST_AUTO_TEST_CASE(expression_for_each_variable_visitor_test) {
         expected_rotations.begin(), expected_rotations.end());
 }
 
+BOOST_AUTO_TEST_CASE(compiled_expression_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+    using value_type = typename variable_type::assignment_type;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+    variable_type w3(6, 2, variable_type::column_type::constant);
+
+    // (w0 + w1) and w1 * w2 repeat, 2 * 3 and (w3 - w3 + 1) fold to constants.
+    expression<variable_type> expr = (w0 + w1) * (w2 + w3) + (w0 + w1).pow(3) * w2 * w1
+        - value_type(2u) * value_type(3u) * w1 * w2 * (w3 - w3 + 1) + w3.pow(0);
+
+    compiled_expression<variable_type> program(expr);
+    BOOST_CHECK_EQUAL(program.variables().size(), 4);
+
+    // 2 loads, the sum, and one multiplication, in 2 registers.
+    compiled_expression<variable_type> square((w0 + w1) * (w1 + w0));
+    BOOST_CHECK_EQUAL(square.instructions().size(), 4);
+    BOOST_CHECK_EQUAL(square.registers_count(), 2);
+
+    // More rows than a block, and a start that is not at a block boundary.
+    const std::size_t rows = 3 * compiled_expression<variable_type>::block_size + 5;
+    std::vector<std::vector<value_type>> columns(program.variables().size(), std::vector<value_type>(rows));
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        for (std::size_t row = 0; row < rows; ++row) {
+            columns[i][row] = value_type(7u * row + 13u * i + 1u);
+        }
+    }
+    std::vector<const std::vector<value_type>*> column_pointers;
+    for (const auto& column : columns) {
+        column_pointers.push_back(&column);
+    }
+
+    std::vector<value_type> result(rows);
+    program.evaluate(column_pointers, 0, 10, result);
+    program.evaluate(column_pointers, 10, rows, result);
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        expression_evaluator<variable_type> evaluator(
+            expr,
+            [&program, &columns, row](const variable_type& var) -> const value_type& {
+                for (std::size_t i = 0; i < program.variables().size(); ++i) {
+                    if (program.variables()[i] == var) return columns[i][row];
+                }
+                std::cerr << "Variable not found" << std::endl;
+                abort();
+            }
+        );
+        BOOST_CHECK(result[row] == evaluator.evaluate());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
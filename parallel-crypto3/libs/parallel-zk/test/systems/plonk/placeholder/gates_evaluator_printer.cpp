@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// Prints the gate evaluator of the circuit of gates_evaluator_test_circuit.hpp, at build time.
+
+#include <iostream>
+
+#include "gates_evaluator_test_circuit.hpp"
+
+#include <nil/blueprint/transpiler/gates_evaluator_cpp_gen.hpp>
+
+int main(int argc, char* argv[]) {
+    using namespace gates_evaluator_test;
+
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <output file>" << std::endl;
+        return 1;
+    }
+
+    circuit_type circuit = make_circuit();
+    plonk_table_description<field_type> desc = make_table_description(circuit);
+    typename policy_type::constraint_system_type constraint_system(
+        circuit.gates, circuit.copy_constraints, circuit.lookup_gates);
+    lpc_scheme_type lpc_scheme(make_fri_params(circuit));
+
+    typename public_preprocessor_type::preprocessed_data_type public_data =
+        public_preprocessor_type::process(constraint_system, circuit.table.public_table(), desc, lpc_scheme);
+
+    nil::blueprint::gates_evaluator_cpp_printer<placeholder_params_type> printer(
+        constraint_system, evaluator_key(public_data), field_type_name, field_includes);
+    printer.print(argv[1]);
+    return 0;
+}
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// The circuit of the printed gate evaluator test. The evaluator is printed by gates_evaluator_printer.cpp at build
+// time and compiled into placeholder_printed_gates_evaluator.cpp, both build the same circuit from this header.
+
+#ifndef CRYPTO3_ZK_TEST_PLACEHOLDER_GATES_EVALUATOR_TEST_CIRCUIT_HPP
+#define CRYPTO3_ZK_TEST_PLACEHOLDER_GATES_EVALUATOR_TEST_CIRCUIT_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <nil/crypto3/algebra/curves/bls12.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/compiled_gates_evaluator.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
+
+#include "circuits.hpp"
+
+namespace gates_evaluator_test {
+    using namespace nil::crypto3;
+    using namespace nil::crypto3::zk;
+    using namespace nil::crypto3::zk::snark;
+
+    using curve_type = algebra::curves::bls12<381>;
+    using field_type = typename curve_type::scalar_field_type;
+
+    // The field as it is named in the printed code, and the headers that declare it.
+    const std::string field_type_name = "nil::crypto3::algebra::curves::bls12<381>::scalar_field_type";
+    const std::vector<std::string> field_includes = {
+        "nil/crypto3/algebra/curves/bls12.hpp",
+        "nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp"
+    };
+
+    constexpr static const std::size_t lambda = 10;
+
+    using hash_type = hashes::keccak_1600<256>;
+    using circuit_params_type = placeholder_circuit_params<field_type>;
+    using lpc_params_type = commitments::list_polynomial_commitment_params<hash_type, hash_type, 2>;
+    using lpc_type = commitments::list_polynomial_commitment<field_type, lpc_params_type>;
+    using lpc_scheme_type = typename commitments::lpc_commitment_scheme<lpc_type>;
+    using placeholder_params_type = placeholder_params<circuit_params_type, lpc_scheme_type>;
+    using policy_type = zk::snark::detail::placeholder_policy<field_type, placeholder_params_type>;
+    using public_preprocessor_type = placeholder_public_preprocessor<field_type, placeholder_params_type>;
+    using circuit_type = circuit_description<field_type, circuit_params_type>;
+
+    // Gates with rotations by -1 and 1 over 30 witness columns. The random values of the table do not change the
+    // constraint system, nor the key of its evaluator.
+    inline circuit_type make_circuit() {
+        return circuit_test_5<field_type>();
+    }
+
+    inline plonk_table_description<field_type> make_table_description(const circuit_type& circuit) {
+        return plonk_table_description<field_type>(
+            circuit.table.witnesses().size(),
+            circuit.table.public_inputs().size(),
+            circuit.table.constants().size(),
+            circuit.table.selectors().size(),
+            circuit.usable_rows,
+            circuit.table_rows);
+    }
+
+    inline typename lpc_type::fri_type::params_type make_fri_params(const circuit_type& circuit) {
+        return typename lpc_type::fri_type::params_type(1, std::log2(circuit.table_rows), lambda, 4);
+    }
+
+    // The key under which the prover looks up the evaluator of the circuit.
+    inline std::string evaluator_key(const typename public_preprocessor_type::preprocessed_data_type& public_data) {
+        return compiled_gates_evaluators<field_type>::key(public_data.common_data.vk.constraint_system_with_params_hash);
+    }
+}    // namespace gates_evaluator_test
+
+#endif    // CRYPTO3_ZK_TEST_PLACEHOLDER_GATES_EVALUATOR_TEST_CIRCUIT_HPP
@@ -35,6 +35,8 @@
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
 
+#include <span>
+
 #include <nil/crypto3/algebra/curves/bls12.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 #include <nil/crypto3/hash/poseidon.hpp>
@@ -42,6 +44,8 @@
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/prover.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/verifier.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/gates_argument.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/compiled_gates_evaluator.hpp>
+#include <nil/crypto3/zk/math/compiled_expression.hpp>
 
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
@@ -228,4 +232,142 @@ BOOST_AUTO_TEST_SUITE(placeholder_gate_argument)
         BOOST_CHECK(prover_res[0].evaluate(y) == verifier_res[0]);
     }
 
+    // Stands in for the code printed by the transpiler: evaluates the gates in the layout of compiled_gates_evaluator.
+    struct test_gates_evaluator {
+        using value_type = typename field_type::value_type;
+        using variable_type = plonk_variable<value_type>;
+        using program_type = math::compiled_expression<variable_type>;
+
+        static inline std::vector<variable_type> variables;
+        // Selector index in 'variables' and the constraints of each gate.
+        static inline std::vector<std::pair<std::size_t, std::vector<program_type>>> gates;
+
+        static std::size_t variable_index(const variable_type& var) {
+            auto it = std::find(variables.begin(), variables.end(), var);
+            if (it != variables.end())
+                return it - variables.begin();
+            variables.push_back(var);
+            return variables.size() - 1;
+        }
+
+        static compiled_gates_evaluator<field_type> build(
+                const std::vector<plonk_gate<field_type, plonk_constraint<field_type>>>& circuit_gates) {
+            variables.clear();
+            gates.clear();
+            std::size_t constraints_count = 0;
+            for (const auto& gate : circuit_gates) {
+                std::vector<program_type> constraints;
+                for (const auto& constraint : gate.constraints) {
+                    constraints.emplace_back(constraint);
+                    for (const auto& var : constraints.back().variables())
+                        variable_index(var);
+                }
+                constraints_count += constraints.size();
+                variable_type selector(gate.selector_index, 0, false, variable_type::column_type::selector);
+                gates.emplace_back(variable_index(selector), std::move(constraints));
+            }
+            return {variables, constraints_count, &evaluate};
+        }
+
+        static void evaluate(const value_type* values, std::size_t rows,
+                             const value_type* theta_powers, value_type* result) {
+            std::vector<std::span<const value_type>> columns;
+            for (std::size_t i = 0; i < variables.size(); ++i)
+                columns.emplace_back(values + i * rows, rows);
+
+            std::fill(result, result + rows, value_type::zero());
+            std::vector<value_type> constraint_values(rows);
+            std::size_t k = 0;
+            for (const auto& [selector, constraints] : gates) {
+                std::vector<value_type> gate_values(rows, value_type::zero());
+                for (const auto& program : constraints) {
+                    std::vector<const std::span<const value_type>*> program_columns;
+                    for (const auto& var : program.variables())
+                        program_columns.push_back(&columns[variable_index(var)]);
+                    program.evaluate(program_columns, 0, rows, constraint_values);
+                    for (std::size_t r = 0; r < rows; ++r)
+                        gate_values[r] += theta_powers[k] * constraint_values[r];
+                    ++k;
+                }
+                for (std::size_t r = 0; r < rows; ++r)
+                    result[r] += gate_values[r] * columns[selector][r];
+            }
+        }
+    };
+
+    BOOST_FIXTURE_TEST_CASE(placeholder_gate_argument_compiled_evaluator_test, test_tools::random_test_initializer<field_type>) {
+        auto pi0 = alg_random_engines.template get_alg_engine<field_type>()();
+        auto circuit = circuit_test_t<field_type>(
+                pi0,
+                alg_random_engines.template get_alg_engine<field_type>(),
+                generic_random_engine
+        );
+
+        plonk_table_description<field_type> desc(
+                circuit.table.witnesses().size(),
+                circuit.table.public_inputs().size(),
+                circuit.table.constants().size(),
+                circuit.table.selectors().size(),
+                circuit.usable_rows,
+                circuit.table_rows);
+
+        std::size_t table_rows_log = std::log2(desc.rows_amount);
+
+        typename policy_type::constraint_system_type constraint_system(
+                circuit.gates, circuit.copy_constraints, circuit.lookup_gates);
+        typename policy_type::variable_assignment_type assignments = circuit.table;
+
+        typename lpc_type::fri_type::params_type fri_params(1, table_rows_log, placeholder_test_params::lambda, 4);
+        lpc_scheme_type lpc_scheme(fri_params);
+
+        typename placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+                preprocessed_public_data = placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::process(
+                constraint_system, assignments.public_table(), desc, lpc_scheme
+        );
+
+        typename placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+                preprocessed_private_data = placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::process(
+                constraint_system, assignments.private_table(), desc
+        );
+
+        auto polynomial_table =
+                plonk_polynomial_dfs_table<field_type>(
+                        preprocessed_private_data.private_polynomial_table,
+                        preprocessed_public_data.public_polynomial_table);
+
+        math::polynomial_dfs<typename field_type::value_type> mask_polynomial(
+                0, preprocessed_public_data.common_data.basic_domain->m,
+                typename field_type::value_type(1)
+        );
+        mask_polynomial -= preprocessed_public_data.q_last;
+        mask_polynomial -= preprocessed_public_data.q_blind;
+
+        compiled_gates_evaluators<field_type>::instance().add("test", test_gates_evaluator::build(constraint_system.gates()));
+        const compiled_gates_evaluator<field_type>* evaluator = compiled_gates_evaluators<field_type>::instance().find("test");
+        BOOST_CHECK(evaluator != nullptr);
+        BOOST_CHECK(compiled_gates_evaluators<field_type>::instance().find("missing") == nullptr);
+
+        std::vector<std::uint8_t> init_blob{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        transcript_type interpreted_transcript(init_blob);
+        transcript_type compiled_transcript(init_blob);
+
+        auto interpreted_res = placeholder_gates_argument<field_type, lpc_placeholder_params_type>::prove_eval(
+                constraint_system, polynomial_table, preprocessed_public_data.common_data.basic_domain,
+                preprocessed_public_data.common_data.max_gates_degree,
+                mask_polynomial, preprocessed_public_data.common_data.lagrange_0,
+                interpreted_transcript
+        );
+        auto compiled_res = placeholder_gates_argument<field_type, lpc_placeholder_params_type>::prove_eval(
+                constraint_system, polynomial_table, preprocessed_public_data.common_data.basic_domain,
+                preprocessed_public_data.common_data.max_gates_degree,
+                mask_polynomial, preprocessed_public_data.common_data.lagrange_0,
+                compiled_transcript, evaluator
+        );
+
+        typename field_type::value_type y = algebra::random_element<field_type>();
+        BOOST_CHECK(interpreted_res[0].evaluate(y) == compiled_res[0].evaluate(y));
+        BOOST_CHECK(interpreted_transcript.template challenge<field_type>() ==
+                    compiled_transcript.template challenge<field_type>());
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -263,6 +263,58 @@ BOOST_AUTO_TEST_SUITE(placeholder_circuit3_lookup_test)
         }
     }
 
+    BOOST_FIXTURE_TEST_CASE(lookup_input_not_in_table_test, test_tools::random_test_initializer<field_type>) {
+        auto circuit = circuit_test_3<field_type>(
+                alg_random_engines.template get_alg_engine<field_type>(),
+                generic_random_engine
+        );
+
+        plonk_table_description<field_type> desc(
+                circuit.table.witnesses().size(),
+                circuit.table.public_inputs().size(),
+                circuit.table.constants().size(),
+                circuit.table.selectors().size(),
+                circuit.usable_rows,
+                circuit.table_rows);
+
+        std::size_t table_rows_log = std::log2(desc.rows_amount);
+
+        typename policy_type::constraint_system_type constraint_system(
+                circuit.gates,
+                circuit.copy_constraints,
+                circuit.lookup_gates,
+                circuit.lookup_tables
+        );
+        typename policy_type::variable_assignment_type assignments = circuit.table;
+        // The first row is selected for the lookup, (2, 0, 0) is not a row of the table.
+        assignments.witness(0, 0) = 2u;
+
+        typename lpc_type::fri_type::params_type fri_params(1, table_rows_log, placeholder_test_params::lambda, 4,
+                                                            true);
+        lpc_scheme_type lpc_scheme(fri_params);
+
+        typename placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+                preprocessed_public_data = placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>::process(
+                constraint_system, assignments.public_table(), desc, lpc_scheme);
+
+        typename placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::preprocessed_data_type
+                preprocessed_private_data = placeholder_private_preprocessor<field_type, lpc_placeholder_params_type>::process(
+                constraint_system, assignments.private_table(), desc);
+
+        auto polynomial_table =
+                plonk_polynomial_dfs_table<field_type>(
+                        preprocessed_private_data.private_polynomial_table,
+                        preprocessed_public_data.public_polynomial_table
+                );
+
+        std::vector<std::uint8_t> init_blob{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        transcript_type prover_transcript(init_blob);
+
+        placeholder_lookup_argument_prover<field_type, lpc_scheme_type, lpc_placeholder_params_type> lookup_prover(
+                constraint_system, preprocessed_public_data, polynomial_table, lpc_scheme, prover_transcript);
+        BOOST_CHECK_THROW(lookup_prover.prove_eval(), std::invalid_argument);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(placeholder_circuit4_lookup_test)
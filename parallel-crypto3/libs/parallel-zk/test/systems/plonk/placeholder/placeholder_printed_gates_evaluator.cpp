@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// Test the gate evaluator printed by the transpiler for circuit_test_5. It is printed at build time by
+// gates_evaluator_printer.cpp and compiled into this test, where it registers itself.
+
+#define BOOST_TEST_MODULE placeholder_printed_gates_evaluator_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/prover.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/verifier.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/gates_argument.hpp>
+#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+
+#include "gates_evaluator_test_circuit.hpp"
+
+using namespace gates_evaluator_test;
+
+BOOST_AUTO_TEST_SUITE(placeholder_printed_gates_evaluator)
+    using transcript_type = typename transcript::fiat_shamir_heuristic_sequential<hash_type>;
+    using private_preprocessor_type = placeholder_private_preprocessor<field_type, placeholder_params_type>;
+    using gates_argument_type = placeholder_gates_argument<field_type, placeholder_params_type>;
+
+    struct printed_gates_evaluator_fixture {
+        printed_gates_evaluator_fixture()
+            : circuit(make_circuit()),
+              desc(make_table_description(circuit)),
+              constraint_system(circuit.gates, circuit.copy_constraints, circuit.lookup_gates),
+              lpc_scheme(make_fri_params(circuit)),
+              public_data(public_preprocessor_type::process(
+                  constraint_system, circuit.table.public_table(), desc, lpc_scheme)),
+              private_data(private_preprocessor_type::process(
+                  constraint_system, circuit.table.private_table(), desc)) {
+        }
+
+        circuit_type circuit;
+        plonk_table_description<field_type> desc;
+        typename policy_type::constraint_system_type constraint_system;
+        lpc_scheme_type lpc_scheme;
+        typename public_preprocessor_type::preprocessed_data_type public_data;
+        typename private_preprocessor_type::preprocessed_data_type private_data;
+    };
+
+    BOOST_FIXTURE_TEST_CASE(printed_gates_evaluator_prove_eval_test, printed_gates_evaluator_fixture) {
+        const compiled_gates_evaluator<field_type>* evaluator =
+            compiled_gates_evaluators<field_type>::instance().find(evaluator_key(public_data));
+        BOOST_REQUIRE(evaluator != nullptr);
+
+        auto polynomial_table = plonk_polynomial_dfs_table<field_type>(
+            private_data.private_polynomial_table, public_data.public_polynomial_table);
+
+        math::polynomial_dfs<typename field_type::value_type> mask_polynomial(
+            0, public_data.common_data.basic_domain->m, typename field_type::value_type(1));
+        mask_polynomial -= public_data.q_last;
+        mask_polynomial -= public_data.q_blind;
+
+        std::vector<std::uint8_t> init_blob{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        transcript_type interpreted_transcript(init_blob);
+        transcript_type compiled_transcript(init_blob);
+
+        auto interpreted_res = gates_argument_type::prove_eval(
+            constraint_system, polynomial_table, public_data.common_data.basic_domain,
+            public_data.common_data.max_gates_degree, mask_polynomial, public_data.common_data.lagrange_0,
+            interpreted_transcript);
+        auto compiled_res = gates_argument_type::prove_eval(
+            constraint_system, polynomial_table, public_data.common_data.basic_domain,
+            public_data.common_data.max_gates_degree, mask_polynomial, public_data.common_data.lagrange_0,
+            compiled_transcript, evaluator);
+
+        typename field_type::value_type y = algebra::random_element<field_type>();
+        BOOST_CHECK(interpreted_res[0].evaluate(y) == compiled_res[0].evaluate(y));
+        BOOST_CHECK(interpreted_transcript.template challenge<field_type>() ==
+                    compiled_transcript.template challenge<field_type>());
+    }
+
+    // The prover finds the evaluator by itself.
+    BOOST_FIXTURE_TEST_CASE(printed_gates_evaluator_proof_test, printed_gates_evaluator_fixture) {
+        auto proof = placeholder_prover<field_type, placeholder_params_type>::process(
+            public_data, std::move(private_data), desc, constraint_system, lpc_scheme);
+
+        lpc_scheme_type verifier_lpc_scheme(make_fri_params(circuit));
+        bool verifier_res = placeholder_verifier<field_type, placeholder_params_type>::process(
+            public_data.common_data, proof, desc, constraint_system, verifier_lpc_scheme);
+        BOOST_CHECK(verifier_res);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
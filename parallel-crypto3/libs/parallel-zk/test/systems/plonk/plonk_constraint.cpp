@@ -45,6 +45,9 @@
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/params.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/detail/column_polynomial.hpp>
+
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
 using namespace nil::crypto3;
 
@@ -145,4 +148,41 @@ BOOST_AUTO_TEST_CASE(plonk_copy_constraint_constructor_test) {
 //    copy_constraint_type cp18({w0, w}); // Fails with assertion
 }
 
+BOOST_AUTO_TEST_CASE(plonk_column_polynomial_dfs_degree_test) {
+    using value_type = typename FieldType::value_type;
+    using column_type = zk::snark::plonk_column<FieldType>;
+
+    const std::size_t rows = 8;
+    column_type constant_column(rows, value_type(5u));
+    column_type zero_column(rows, value_type::zero());
+    column_type column(rows);
+    for (std::size_t i = 0; i < rows; i++) {
+        column[i] = value_type(i + 1);
+    }
+
+    BOOST_CHECK_EQUAL(zk::snark::detail::column_polynomial_dfs_degree<FieldType>(constant_column), 0);
+    BOOST_CHECK_EQUAL(zk::snark::detail::column_polynomial_dfs_degree<FieldType>(zero_column), 0);
+    BOOST_CHECK_EQUAL(zk::snark::detail::column_polynomial_dfs_degree<FieldType>(column), rows - 1);
+    BOOST_CHECK_EQUAL(zk::snark::detail::column_polynomial_dfs_degree<FieldType>(column_type(1, value_type(3u))), 0);
+
+    auto domain = math::make_evaluation_domain<FieldType>(rows);
+    std::vector<math::polynomial_dfs<value_type>> polys =
+        zk::snark::detail::column_range_polynomial_dfs<FieldType>({constant_column, zero_column, column}, domain);
+    BOOST_CHECK_EQUAL(polys[0].degree(), 0);
+    BOOST_CHECK_EQUAL(polys[1].degree(), 0);
+    BOOST_CHECK_EQUAL(polys[2].degree(), rows - 1);
+
+    math::polynomial_dfs<value_type> constant_poly =
+        zk::snark::detail::column_polynomial_dfs<FieldType>(constant_column, domain);
+    BOOST_CHECK_EQUAL(constant_poly.degree(), 0);
+    BOOST_CHECK_EQUAL(constant_poly.size(), rows);
+
+    value_type point = algebra::random_element<FieldType>();
+    BOOST_CHECK(polys[0].evaluate(point) == value_type(5u));
+    BOOST_CHECK(polys[1].evaluate(point) == value_type::zero());
+    BOOST_CHECK(constant_poly.evaluate(point) == value_type(5u));
+    BOOST_CHECK(polys[2].evaluate(point) ==
+                zk::snark::detail::column_polynomial<FieldType>(column, domain).evaluate(point));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
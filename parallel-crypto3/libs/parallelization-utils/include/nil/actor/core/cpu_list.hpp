@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_CPU_LIST_HPP
+#define CRYPTO3_CPU_LIST_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+
+        /**
+         * Returns the CPUs of the given NUMA node, as listed by the kernel in
+         * /sys/devices/system/node/node<N>/cpulist. Throws if the node does not exist.
+         */
+        std::vector<std::size_t> numa_node_cpu_list(std::size_t node);
+
+        /**
+         * Parses a list of CPUs in the format used by the kernel and taskset, like "0-7,16,18-19".
+         * Additionally an entry "node<N>" means all the CPUs of the NUMA node N.
+         */
+        inline std::vector<std::size_t> parse_cpu_list(const std::string& cpu_list) {
+            std::vector<std::size_t> cpus;
+            std::stringstream stream(cpu_list);
+            std::string entry;
+            while (std::getline(stream, entry, ',')) {
+                entry.erase(0, entry.find_first_not_of(" \t\n"));
+                entry.erase(entry.find_last_not_of(" \t\n") + 1);
+                if (entry.empty())
+                    continue;
+
+                try {
+                    if (entry.rfind("node", 0) == 0) {
+                        std::vector<std::size_t> node_cpus = numa_node_cpu_list(std::stoul(entry.substr(4)));
+                        cpus.insert(cpus.end(), node_cpus.begin(), node_cpus.end());
+                        continue;
+                    }
+
+                    std::size_t dash = entry.find('-');
+                    std::size_t first = std::stoul(entry.substr(0, dash));
+                    std::size_t last = (dash == std::string::npos) ? first : std::stoul(entry.substr(dash + 1));
+                    if (last < first)
+                        throw std::invalid_argument("Invalid CPU range");
+                    for (std::size_t cpu = first; cpu <= last; ++cpu) {
+                        cpus.push_back(cpu);
+                    }
+                } catch (const std::logic_error&) {
+                    throw std::invalid_argument("Invalid CPU list entry '" + entry + "' in '" + cpu_list + "'.");
+                }
+            }
+            return cpus;
+        }
+
+        inline std::vector<std::size_t> numa_node_cpu_list(std::size_t node) {
+            std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            std::ifstream file(path);
+            std::string line;
+            if (!file || !std::getline(file, line))
+                throw std::runtime_error("Cannot read the CPUs of NUMA node " + std::to_string(node) + " from " + path);
+            return parse_cpu_list(line);
+        }
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_CPU_LIST_HPP
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
+#define CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+
+        namespace detail {
+            // Writes each page of the n elements from the pool thread that will most likely process it later: it
+            // uses the same chunking as parallel_for_chunks over 'n' elements. Touching a page costs next to
+            // nothing, the chunk size is fixed to the default one, so the tuner does not merge all the pages into
+            // a single chunk.
+            template<typename T>
+            void first_touch_pages(T* data, std::size_t n) {
+#ifdef __linux__
+                static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+#else
+                static const std::size_t page_size = 4096;
+#endif
+                char* memory = reinterpret_cast<char*>(data);
+                parallel_for_chunks(n,
+                    [memory](std::size_t begin, std::size_t end) {
+                        std::size_t first_byte = begin * sizeof(T);
+                        std::size_t last_byte = end * sizeof(T);
+                        // Pages shared by 2 chunks belong to the chunk that contains the start of the page.
+                        std::size_t page_start = (first_byte + page_size - 1) / page_size * page_size;
+                        for (; page_start < last_byte; page_start += page_size) {
+                            *static_cast<volatile char*>(memory + page_start) = 0;
+                        }
+                    }, ThreadPool::PoolLevel::LOW, POOL_0_MIN_CHUNK_SIZE);
+            }
+        }    // namespace detail
+
+        /**
+         * Allocator for large vectors that are processed with parallel_for_chunks afterwards, like the columns
+         * of the extended domain in the prover. The kernel places a page on the NUMA node of the thread that
+         * writes it first, so after allocating we write each page from the pool thread that processes
+         * the chunk of elements the page belongs to. Without that all the pages land on the node of the thread
+         * that called 'resize', and half of the workers of a dual-socket machine read remote memory.
+         *
+         * Blocks smaller than 'min_first_touch_bytes' are not worth a round trip to the pool, they come from
+         * std::allocator.
+         */
+        template<typename T>
+        class first_touch_allocator {
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using propagate_on_container_move_assignment = std::true_type;
+            using is_always_equal = std::true_type;
+
+            static constexpr std::size_t min_first_touch_bytes = std::size_t(1) << 21;
+
+            first_touch_allocator() noexcept = default;
+
+            template<typename U>
+            first_touch_allocator(const first_touch_allocator<U>&) noexcept {
+            }
+
+            T* allocate(std::size_t n) {
+                if (n * sizeof(T) < min_first_touch_bytes)
+                    return std::allocator<T>().allocate(n);
+
+#ifdef __linux__
+                // Take the memory directly from the kernel, malloc may return pages that were already
+                // touched by some other thread.
+                void* memory = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (memory == MAP_FAILED)
+                    throw std::bad_alloc();
+                T* result = static_cast<T*>(memory);
+#else
+                T* result = std::allocator<T>().allocate(n);
+#endif
+                detail::first_touch_pages(result, n);
+                return result;
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                if (n * sizeof(T) < min_first_touch_bytes) {
+                    std::allocator<T>().deallocate(p, n);
+                    return;
+                }
+#ifdef __linux__
+                munmap(p, n * sizeof(T));
+#else
+                std::allocator<T>().deallocate(p, n);
+#endif
+            }
+
+            template<typename U>
+            bool operator==(const first_touch_allocator<U>&) const noexcept {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const first_touch_allocator<U>&) const noexcept {
+                return false;
+            }
+        };
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
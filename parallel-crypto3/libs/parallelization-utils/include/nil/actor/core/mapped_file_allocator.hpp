@@ -0,0 +1,201 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_MAPPED_FILE_ALLOCATOR_HPP
+#define CRYPTO3_MAPPED_FILE_ALLOCATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+
+        /**
+         * Storage of large vectors in memory mapped files. Each block is a shared mapping of its own temporary
+         * file, so the kernel writes its pages back to the disk under memory pressure instead of failing the
+         * allocation, and reads them again when they are accessed. The files are removed as soon as they are
+         * mapped, their space is freed by the kernel when the block is unmapped or the process exits.
+         *
+         * The blocks get the default paging. The FFT stages and the Merkle leaves read them with large strides, so
+         * the sequential advice, with which the kernel reads ahead and drops the pages already passed first, is
+         * only set by the callers whose loops go over the blocks in order, see set_sequential_access.
+         */
+        class mapped_file_storage {
+        public:
+            static mapped_file_storage& instance() {
+                // Never destroyed, vectors in static objects may be freed after the end of main.
+                static mapped_file_storage* storage = new mapped_file_storage();
+                return *storage;
+            }
+
+            // Sets the directory of the temporary files, it should be on a fast local disk.
+            void set_directory(const std::string& path) {
+                std::lock_guard<std::mutex> lock(mutex);
+                directory = path;
+            }
+
+            std::string get_directory() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return directory;
+            }
+
+            // Advises the blocks mapped from now on as read in order, MADV_SEQUENTIAL, or as MADV_NORMAL.
+            void set_sequential_access(bool sequential) {
+                sequential_access = sequential;
+            }
+
+            bool get_sequential_access() const {
+                return sequential_access;
+            }
+
+            // Returns the total size of the blocks mapped now in bytes.
+            std::size_t get_mapped_bytes() const {
+                return mapped_bytes;
+            }
+
+            // Returns the largest total size of the blocks mapped at a time so far in bytes.
+            std::size_t get_peak_mapped_bytes() const {
+                return peak_mapped_bytes;
+            }
+
+            void* map(std::size_t bytes) {
+#ifdef __linux__
+                std::string path = get_directory() + "/crypto3_polynomial_XXXXXX";
+                std::vector<char> name(path.begin(), path.end());
+                name.push_back('\0');
+
+                int fd = mkstemp(name.data());
+                if (fd == -1)
+                    throw std::bad_alloc();
+                unlink(name.data());
+
+                if (ftruncate(fd, bytes) != 0) {
+                    close(fd);
+                    throw std::bad_alloc();
+                }
+                void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                // The mapping keeps the file alive.
+                close(fd);
+                if (memory == MAP_FAILED)
+                    throw std::bad_alloc();
+
+                madvise(memory, bytes, sequential_access ? MADV_SEQUENTIAL : MADV_NORMAL);
+                std::size_t total = mapped_bytes += bytes;
+                std::size_t peak = peak_mapped_bytes;
+                while (peak < total && !peak_mapped_bytes.compare_exchange_weak(peak, total)) {
+                }
+                return memory;
+#else
+                return ::operator new(bytes);
+#endif
+            }
+
+            void unmap(void* p, std::size_t bytes) noexcept {
+#ifdef __linux__
+                munmap(p, bytes);
+                mapped_bytes -= bytes;
+#else
+                ::operator delete(p);
+#endif
+            }
+
+        private:
+            mapped_file_storage() {
+                const char* tmpdir = std::getenv("TMPDIR");
+                directory = tmpdir != nullptr ? tmpdir : "/var/tmp";
+            }
+
+            mutable std::mutex mutex;
+            std::string directory;
+            std::atomic<std::size_t> mapped_bytes = 0;
+            std::atomic<std::size_t> peak_mapped_bytes = 0;
+            std::atomic<bool> sequential_access = false;
+        };
+
+        /**
+         * Allocator that keeps large vectors in memory mapped files, see mapped_file_storage. Used as the Allocator
+         * of polynomial_dfs, it lets the polynomials of a table larger than the memory live on the disk, and be
+         * processed at the speed of the disk.
+         *
+         * Blocks smaller than 'min_mapped_bytes' come from std::allocator.
+         */
+        template<typename T>
+        class mapped_file_allocator {
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using propagate_on_container_move_assignment = std::true_type;
+            using is_always_equal = std::true_type;
+
+            static constexpr std::size_t min_mapped_bytes = std::size_t(1) << 21;
+
+            mapped_file_allocator() noexcept = default;
+
+            template<typename U>
+            mapped_file_allocator(const mapped_file_allocator<U>&) noexcept {
+            }
+
+            T* allocate(std::size_t n) {
+                if (n * sizeof(T) < min_mapped_bytes)
+                    return std::allocator<T>().allocate(n);
+                return static_cast<T*>(mapped_file_storage::instance().map(n * sizeof(T)));
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                if (n * sizeof(T) < min_mapped_bytes) {
+                    std::allocator<T>().deallocate(p, n);
+                    return;
+                }
+                mapped_file_storage::instance().unmap(p, n * sizeof(T));
+            }
+
+            template<typename U>
+            bool operator==(const mapped_file_allocator<U>&) const noexcept {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const mapped_file_allocator<U>&) const noexcept {
+                return false;
+            }
+        };
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_MAPPED_FILE_ALLOCATOR_HPP
@@ -25,26 +25,429 @@
 #ifndef CRYPTO3_PARALLELIZATION_UTILS_HPP
 #define CRYPTO3_PARALLELIZATION_UTILS_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
 #include <future>
+#include <iterator>
+#include <numeric>
+#include <vector>
 
 #include <nil/actor/core/thread_pool.hpp>
 
 namespace nil {
     namespace crypto3 {
 
+        // Passed as 'min_chunk_size' to let the loop measure the cost of its elements and pick the chunk size itself.
+        static constexpr std::size_t AUTO_CHUNK_SIZE = 0;
+
+        // Waits for all the futures, the calling thread executes pending tasks of the pool while waiting,
+        // so it's safe to call this from inside a task running in the pool.
         template<class ReturnType>
         std::vector<ReturnType> wait_for_all(std::vector<std::future<ReturnType>> futures) {
+            auto& thread_pool = ThreadPool::get_instance();
             std::vector<ReturnType> results;
             for (auto& f: futures) {
-                results.push_back(f.get());
+                results.push_back(thread_pool.wait(f));
             }
             return results;
         }
 
         inline void wait_for_all(std::vector<std::future<void>> futures) {
+            auto& thread_pool = ThreadPool::get_instance();
             for (auto& f: futures) {
-                f.get();
+                thread_pool.wait(f);
+            }
+        }
+
+        namespace detail {
+
+            /**
+             * Task living on the stack of the thread that forked it. The owner must wait until is_done() returns
+             * true before leaving the scope, so no allocation is needed to pass the work to the pool.
+             */
+            template<class Func>
+            class stack_task : public pool_task {
+            public:
+                explicit stack_task(Func& func) : func(func) {
+                }
+
+                void execute() override {
+                    try {
+                        func();
+                    } catch (...) {
+                        exception = std::current_exception();
+                    }
+                    // Must be the last access to this object, the owner may destroy it right after.
+                    done.store(true, std::memory_order_release);
+                }
+
+                bool is_done() const {
+                    return done.load(std::memory_order_acquire);
+                }
+
+                void rethrow_if_failed() const {
+                    if (exception)
+                        std::rethrow_exception(exception);
+                }
+
+            private:
+                Func& func;
+                std::exception_ptr exception;
+                std::atomic<bool> done = false;
+            };
+
+            // For pool #0 we have experimentally found that operations over chunks of <4096 elements
+            // do not load the cores. In case we have smaller chunks, it's better to load less cores.
+            // Pool #0 takes care of the lowest level of operations, like polynomial operations, so this is the
+            // chunk size we use for it until the actual cost of the elements is known.
+            static constexpr std::size_t POOL_0_MIN_CHUNK_SIZE = 1 << 12;
+
+            // Loops that don't need a chunk index are split into up to this many chunks per worker, so the work
+            // can be rebalanced by stealing when the elements or the workers are not equally fast.
+            static constexpr std::size_t MAX_CHUNKS_PER_WORKER = 4;
+
+            inline std::size_t default_min_chunk_size(ThreadPool::PoolLevel pool_id) {
+                return pool_id == ThreadPool::PoolLevel::LOW ? POOL_0_MIN_CHUNK_SIZE : 1;
+            }
+
+            // Returns the number of chunks of at least 'min_chunk_size' elements, but no more than
+            // 'max_chunks_per_worker' per worker of the pool.
+            inline std::size_t chunks_count(std::size_t elements_count, ThreadPool::PoolLevel pool_id,
+                                            std::size_t min_chunk_size, std::size_t max_chunks_per_worker) {
+                std::size_t max_chunks = ThreadPool::get_instance(pool_id).get_pool_size() * max_chunks_per_worker;
+                return std::max((std::size_t)1, std::min(elements_count / min_chunk_size, max_chunks));
+            }
+
+            // Returns the number of chunks the work of 'elements_count' elements must be split into, one per worker
+            // at most.
+            inline std::size_t chunks_count(std::size_t elements_count, ThreadPool::PoolLevel pool_id) {
+                return chunks_count(elements_count, pool_id, default_min_chunk_size(pool_id), 1);
+            }
+
+            /**
+             * Measured cost of one element of a parallel loop. The time of every chunk is recorded, and the chunk
+             * size is picked so that a chunk runs for about TARGET_CHUNK_TIME: shorter chunks are dominated by the
+             * cost of scheduling them, longer ones leave the workers idle at the end of the loop.
+             * The cost of a field addition and of a Merkle hash differ by orders of magnitude, so each loop has its
+             * own tuner, see call_site_tuner below.
+             */
+            class chunk_size_tuner {
+            public:
+                static constexpr std::chrono::nanoseconds TARGET_CHUNK_TIME = std::chrono::microseconds(100);
+
+                // Returns 'default_size' until the first chunk is measured.
+                std::size_t min_chunk_size(std::size_t default_size) const {
+                    std::uint64_t cost = picoseconds_per_element.load(std::memory_order_relaxed);
+                    if (cost == 0)
+                        return default_size;
+                    std::uint64_t target = std::chrono::duration_cast<std::chrono::duration<std::uint64_t, std::pico>>(
+                        TARGET_CHUNK_TIME).count();
+                    return std::max((std::uint64_t)1, target / cost);
+                }
+
+                void record(std::size_t elements_count, std::chrono::steady_clock::duration time) {
+                    std::uint64_t picoseconds = std::chrono::duration_cast<std::chrono::duration<std::uint64_t, std::pico>>(
+                        time).count();
+                    std::uint64_t cost = std::max((std::uint64_t)1, picoseconds / elements_count);
+                    // A moving average, chunks of the same loop may be measured concurrently, losing some of
+                    // the updates is fine.
+                    std::uint64_t old_cost = picoseconds_per_element.load(std::memory_order_relaxed);
+                    if (old_cost != 0)
+                        cost = (old_cost * 3 + cost) / 4;
+                    picoseconds_per_element.store(cost, std::memory_order_relaxed);
+                }
+
+            private:
+                std::atomic<std::uint64_t> picoseconds_per_element = 0;
+            };
+
+            // Each loop body is a distinct type, so this gives one tuner per call site, shared by all the calls.
+            template<class Func>
+            chunk_size_tuner& call_site_tuner() {
+                static chunk_size_tuner tuner;
+                return tuner;
+            }
+
+            // Start of chunk 'chunk' when 'elements_count' elements are split into 'chunks' almost equal parts.
+            inline std::size_t chunk_begin(std::size_t chunk, std::size_t chunks, std::size_t elements_count) {
+                return chunk * (elements_count / chunks) + std::min(chunk, elements_count % chunks);
+            }
+
+        }    // namespace detail
+
+        /**
+         * Runs 'func1' and 'func2' in parallel and returns when both are completed. 'func2' is offered to the other
+         * workers, 'func1' is executed by the calling thread, which then helps with other work until 'func2' is done.
+         * Nothing is allocated on the heap. If any of the functions throws, the exception is rethrown here.
+         */
+        template<class Func1, class Func2>
+        void parallel_invoke(Func1 func1, Func2 func2) {
+            auto& thread_pool = ThreadPool::get_instance();
+
+            detail::stack_task<Func2> forked_task(func2);
+            thread_pool.submit(&forked_task);
+
+            std::exception_ptr exception;
+            try {
+                func1();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            // Even if func1 failed we must wait, 'forked_task' lives on our stack.
+            thread_pool.help_until([&forked_task]() { return forked_task.is_done(); });
+
+            if (exception)
+                std::rethrow_exception(exception);
+            forked_task.rethrow_if_failed();
+        }
+
+        template<class Func1, class Func2, class Func3, class... Funcs>
+        void parallel_invoke(Func1 func1, Func2 func2, Func3 func3, Funcs... funcs) {
+            parallel_invoke(
+                std::move(func1),
+                [&func2, &func3, &funcs...]() { parallel_invoke(std::move(func2), std::move(func3), std::move(funcs)...); });
+        }
+
+        namespace detail {
+
+            // Recursively forks the chunks in [first_chunk, last_chunk) and calls func(chunk, begin, end) for each.
+            // If 'tuner' is given, the time of each chunk is recorded in it. A chunk whose body waited for nested
+            // work ran other tasks of the pool meanwhile, its time is not the cost of its elements and is dropped.
+            template<class Func>
+            void run_chunks(std::size_t first_chunk, std::size_t last_chunk, std::size_t chunks,
+                            std::size_t elements_count, Func& func, chunk_size_tuner* tuner = nullptr) {
+                if (last_chunk - first_chunk == 1) {
+                    std::size_t begin = chunk_begin(first_chunk, chunks, elements_count);
+                    std::size_t end = chunk_begin(first_chunk + 1, chunks, elements_count);
+                    if (tuner == nullptr || begin == end) {
+                        func(first_chunk, begin, end);
+                        return;
+                    }
+                    std::size_t helped_tasks = ThreadPool::get_helped_tasks_count();
+                    auto start = std::chrono::steady_clock::now();
+                    func(first_chunk, begin, end);
+                    auto time = std::chrono::steady_clock::now() - start;
+                    if (ThreadPool::get_helped_tasks_count() == helped_tasks) {
+                        tuner->record(end - begin, time);
+                    }
+                    return;
+                }
+                std::size_t middle_chunk = first_chunk + (last_chunk - first_chunk) / 2;
+                parallel_invoke(
+                    [first_chunk, middle_chunk, chunks, elements_count, &func, tuner]() {
+                        run_chunks(first_chunk, middle_chunk, chunks, elements_count, func, tuner);
+                    },
+                    [middle_chunk, last_chunk, chunks, elements_count, &func, tuner]() {
+                        run_chunks(middle_chunk, last_chunk, chunks, elements_count, func, tuner);
+                    });
+            }
+
+            // Splits 'elements_count' elements into chunks of at least 'min_chunk_size' elements, or of the size picked
+            // by the tuner of the call site for AUTO_CHUNK_SIZE, and runs them.
+            template<class Func>
+            void run_in_chunks(std::size_t elements_count, Func& func, ThreadPool::PoolLevel pool_id,
+                               std::size_t min_chunk_size, std::size_t max_chunks_per_worker) {
+                if (elements_count == 0)
+                    return;
+                chunk_size_tuner* tuner = nullptr;
+                if (min_chunk_size == AUTO_CHUNK_SIZE) {
+                    tuner = &call_site_tuner<Func>();
+                    min_chunk_size = tuner->min_chunk_size(default_min_chunk_size(pool_id));
+                }
+                std::size_t chunks = chunks_count(elements_count, pool_id, min_chunk_size, max_chunks_per_worker);
+                run_chunks(0, chunks, chunks, elements_count, func, tuner);
             }
+
+        }    // namespace detail
+
+        /**
+         * Divides work into chunks and calls func(thread_id, begin, end) for each of them in parallel, returns
+         * once all the chunks are processed. 'thread_id' is the index of the chunk, it's less than the pool size.
+         * Unlike parallel_run_in_chunks_with_thread_id this does not allocate and does not create futures.
+         *
+         * Chunks have at least 'min_chunk_size' elements. By default the size is tuned at runtime from the time
+         * the previous calls of the same call site took per element.
+         */
+        template<class Func>
+        void parallel_for_chunks_with_thread_id(std::size_t elements_count, Func func,
+                                                ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW,
+                                                std::size_t min_chunk_size = AUTO_CHUNK_SIZE) {
+            detail::run_in_chunks(elements_count, func, pool_id, min_chunk_size, 1);
+        }
+
+        /**
+         * Divides work into chunks and calls func(begin, end) for each of them in parallel. Since the index of
+         * the chunk is not needed, the work may be split into more chunks than the pool has workers.
+         */
+        template<class Func>
+        void parallel_for_chunks(std::size_t elements_count, Func func,
+                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW,
+                                 std::size_t min_chunk_size = AUTO_CHUNK_SIZE) {
+            auto chunk_func = [&func](std::size_t chunk, std::size_t begin, std::size_t end) {
+                func(begin, end);
+            };
+            detail::run_in_chunks(elements_count, chunk_func, pool_id, min_chunk_size,
+                                  detail::MAX_CHUNKS_PER_WORKER);
+        }
+
+        /**
+         * Reduces the range [0, elements_count) in parallel. 'chunk_func(begin, end)' returns the reduced value of a
+         * chunk, the values of the chunks are combined with 'combine' in the order of the chunks, so 'combine'
+         * needs to be associative, but not commutative.
+         */
+        template<class ValueType, class ChunkFunc, class CombineFunc>
+        ValueType parallel_reduce(std::size_t elements_count, ValueType identity, ChunkFunc chunk_func,
+                                  CombineFunc combine, ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            if (elements_count == 0)
+                return identity;
+            std::size_t chunks = detail::chunks_count(elements_count, pool_id);
+            if (chunks == 1)
+                return combine(std::move(identity), chunk_func(std::size_t(0), elements_count));
+
+            std::vector<ValueType> chunk_results(chunks, identity);
+            auto reduce_chunk = [&chunk_results, &chunk_func](std::size_t chunk, std::size_t begin, std::size_t end) {
+                chunk_results[chunk] = chunk_func(begin, end);
+            };
+            detail::run_chunks(0, chunks, chunks, elements_count, reduce_chunk);
+
+            ValueType result = std::move(identity);
+            for (auto& chunk_result : chunk_results) {
+                result = combine(std::move(result), std::move(chunk_result));
+            }
+            return result;
+        }
+
+        /**
+         * Similar to std::inclusive_scan, but in parallel. 'op' must be associative, it is not required to be
+         * commutative. Each chunk is scanned separately, then the results of all the chunks except the first are
+         * combined with the total of the preceding chunks, so 'op' is called about twice per element.
+         * Input and output ranges may be the same.
+         */
+        template<class InputIt, class OutputIt, class BinaryOperation>
+        void parallel_inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOperation op,
+                                     ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            typedef typename std::iterator_traits<InputIt>::value_type value_type;
+
+            std::size_t elements_count = std::distance(first, last);
+            if (elements_count == 0)
+                return;
+            std::size_t chunks = detail::chunks_count(elements_count, pool_id);
+            if (chunks == 1) {
+                std::inclusive_scan(first, last, d_first, op);
+                return;
+            }
+
+            // Both passes and 'chunk_totals' must use the same chunks, so they are run with run_chunks directly.
+            std::vector<value_type> chunk_totals(chunks);
+            auto scan_chunk = [first, d_first, &op, &chunk_totals](std::size_t chunk, std::size_t begin, std::size_t end) {
+                auto out = std::inclusive_scan(std::next(first, begin), std::next(first, end),
+                                               std::next(d_first, begin), op);
+                chunk_totals[chunk] = *std::prev(out);
+            };
+            detail::run_chunks(0, chunks, chunks, elements_count, scan_chunk);
+
+            // Only 'chunks' values here, a serial scan is fine.
+            for (std::size_t i = 1; i < chunks; ++i) {
+                chunk_totals[i] = op(chunk_totals[i - 1], chunk_totals[i]);
+            }
+
+            auto fix_chunk = [d_first, &op, &chunk_totals](std::size_t chunk, std::size_t begin, std::size_t end) {
+                if (chunk == 0)
+                    return;
+                auto out = std::next(d_first, begin);
+                for (std::size_t i = begin; i < end; ++i, ++out) {
+                    *out = op(chunk_totals[chunk - 1], *out);
+                }
+            };
+            detail::run_chunks(0, chunks, chunks, elements_count, fix_chunk);
+        }
+
+        /**
+         * Sorts the range in parallel with a sample sort. The elements are distributed into one bucket per chunk
+         * by splitters taken from a regular sample of the input, then the buckets are sorted independently.
+         * Like std::sort it's not stable. Needs a temporary buffer of the size of the input.
+         */
+        template<class RandomIt, class Compare>
+        void parallel_sort(RandomIt first, RandomIt last, Compare comp,
+                           ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+            std::size_t elements_count = std::distance(first, last);
+            std::size_t chunks = detail::chunks_count(elements_count, pool_id);
+            if (chunks == 1) {
+                std::sort(first, last, comp);
+                return;
+            }
+
+            // Take a regular sample, it gives good splitters unless the input has lots of equal elements.
+            static constexpr std::size_t OVERSAMPLING_FACTOR = 32;
+            std::size_t samples_count = std::min(elements_count, chunks * OVERSAMPLING_FACTOR);
+            std::vector<value_type> samples;
+            samples.reserve(samples_count);
+            for (std::size_t i = 0; i < samples_count; ++i) {
+                samples.push_back(first[i * elements_count / samples_count]);
+            }
+            std::sort(samples.begin(), samples.end(), comp);
+
+            std::size_t buckets = chunks;
+            std::vector<value_type> splitters;
+            for (std::size_t i = 1; i < buckets; ++i) {
+                splitters.push_back(samples[i * samples_count / buckets]);
+            }
+            samples.clear();
+
+            // bucket_offsets[chunk * buckets + bucket] is at first the number of elements of 'chunk' that go to
+            // 'bucket', then it becomes the position where these elements are written.
+            std::vector<std::size_t> element_buckets(elements_count);
+            std::vector<std::size_t> bucket_offsets(chunks * buckets, 0);
+            auto count_chunk = [first, &splitters, &comp, &element_buckets, &bucket_offsets, buckets]
+                (std::size_t chunk, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        element_buckets[i] =
+                            std::upper_bound(splitters.begin(), splitters.end(), first[i], comp) - splitters.begin();
+                        ++bucket_offsets[chunk * buckets + element_buckets[i]];
+                    }
+                };
+            detail::run_chunks(0, chunks, chunks, elements_count, count_chunk);
+
+            std::vector<std::size_t> bucket_begins(buckets + 1, 0);
+            std::size_t offset = 0;
+            for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+                bucket_begins[bucket] = offset;
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    std::size_t count = bucket_offsets[chunk * buckets + bucket];
+                    bucket_offsets[chunk * buckets + bucket] = offset;
+                    offset += count;
+                }
+            }
+            bucket_begins[buckets] = offset;
+
+            std::vector<value_type> buffer(elements_count);
+            auto scatter_chunk = [first, &buffer, &element_buckets, &bucket_offsets, buckets]
+                (std::size_t chunk, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        buffer[bucket_offsets[chunk * buckets + element_buckets[i]]++] = std::move(first[i]);
+                    }
+                };
+            detail::run_chunks(0, chunks, chunks, elements_count, scatter_chunk);
+
+            parallel_for(0, buckets,
+                [first, &buffer, &bucket_begins, &comp](std::size_t bucket) {
+                    auto bucket_begin = buffer.begin() + bucket_begins[bucket];
+                    auto bucket_end = buffer.begin() + bucket_begins[bucket + 1];
+                    std::sort(bucket_begin, bucket_end, comp);
+                    std::move(bucket_begin, bucket_end, first + bucket_begins[bucket]);
+                }, ThreadPool::PoolLevel::HIGH, 1);
+        }
+
+        template<class RandomIt>
+        void parallel_sort(RandomIt first, RandomIt last,
+                           ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            parallel_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), pool_id);
         }
 
         // Divides work into chunks and makes calls to 'func' in parallel.
@@ -57,18 +460,7 @@ namespace nil {
             auto& thread_pool = ThreadPool::get_instance(pool_id);
 
             std::vector<std::future<ReturnType>> fut;
-            std::size_t workers_to_use = std::max((size_t)1, std::min(elements_count, thread_pool.get_pool_size()));
-
-            // For pool #0 we have experimentally found that operations over chunks of <4096 elements
-            // do not load the cores. In case we have smaller chunks, it's better to load less cores.
-            static constexpr std::size_t POOL_0_MIN_CHUNK_SIZE = 1 << 12;
-
-            // Pool #0 will take care of the lowest level of operations, like polynomial operations.
-            // We want the minimal size of elements_per_worker to be 'POOL_0_MIN_CHUNK_SIZE', otherwise the cores are not loaded.
-            if (pool_id == ThreadPool::PoolLevel::LOW && elements_count / workers_to_use < POOL_0_MIN_CHUNK_SIZE) {
-                workers_to_use = elements_count / POOL_0_MIN_CHUNK_SIZE + ((elements_count % POOL_0_MIN_CHUNK_SIZE) ? 1 : 0);
-                workers_to_use = std::max((size_t)1, workers_to_use);
-            }
+            std::size_t workers_to_use = detail::chunks_count(elements_count, pool_id);
 
             std::size_t begin = 0;
             for (std::size_t i = 0; i < workers_to_use; i++) {
@@ -98,20 +490,19 @@ namespace nil {
                                 OutputIt d_first, BinaryOperation binary_op,
                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
 
-            wait_for_all(parallel_run_in_chunks<void>(
+            parallel_for_chunks(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, first2, d_first, binary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(first2, begin);
-                    std::advance(d_first, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        *d_first = binary_op(*first1, *first2);
-                        ++first1;
-                        ++first2;
-                        ++d_first;
+                [first1, first2, d_first, &binary_op](std::size_t begin, std::size_t end) {
+                    auto in1 = std::next(first1, begin);
+                    auto in2 = std::next(first2, begin);
+                    auto out = std::next(d_first, begin);
+                    for (std::size_t i = begin; i < end; i++) {
+                        *out = binary_op(*in1, *in2);
+                        ++in1;
+                        ++in2;
+                        ++out;
                     }
-                }, pool_id));
+                }, pool_id);
         }
 
         // Similar to std::transform, but in parallel. We return void here for better usability for our use cases.
@@ -120,18 +511,17 @@ namespace nil {
                                 OutputIt d_first, UnaryOperation unary_op,
                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
 
-            wait_for_all(parallel_run_in_chunks<void>(
+            parallel_for_chunks(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, d_first, unary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(d_first, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        *d_first = unary_op(*first1);
-                        ++first1;
-                        ++d_first;
+                [first1, d_first, &unary_op](std::size_t begin, std::size_t end) {
+                    auto in = std::next(first1, begin);
+                    auto out = std::next(d_first, begin);
+                    for (std::size_t i = begin; i < end; i++) {
+                        *out = unary_op(*in);
+                        ++in;
+                        ++out;
                     }
-                }, pool_id));
+                }, pool_id);
         }
 
         // This one is an optimization, since copying field elements is quite slow.
@@ -141,18 +531,17 @@ namespace nil {
                                          BinaryOperation binary_op,
                                          ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
 
-            wait_for_all(parallel_run_in_chunks<void>(
+            parallel_for_chunks(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, first2, binary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(first2, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        binary_op(*first1, *first2);
-                        ++first1;
-                        ++first2;
+                [first1, first2, &binary_op](std::size_t begin, std::size_t end) {
+                    auto in1 = std::next(first1, begin);
+                    auto in2 = std::next(first2, begin);
+                    for (std::size_t i = begin; i < end; i++) {
+                        binary_op(*in1, *in2);
+                        ++in1;
+                        ++in2;
                     }
-                }, pool_id));
+                }, pool_id);
         }
 
         // This one is an optimization, since copying field elements is quite slow.
@@ -161,28 +550,31 @@ namespace nil {
         void parallel_foreach(InputIt first1, InputIt last1, UnaryOperation unary_op,
                               ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
 
-            wait_for_all(parallel_run_in_chunks<void>(
+            parallel_for_chunks(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, unary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        unary_op(*first1);
-                        ++first1;
+                [first1, &unary_op](std::size_t begin, std::size_t end) {
+                    auto it = std::next(first1, begin);
+                    for (std::size_t i = begin; i < end; i++) {
+                        unary_op(*it);
+                        ++it;
                     }
-                }, pool_id));
+                }, pool_id);
         }
 
         // Calls function func for each value between [start, end).
-        inline void parallel_for(std::size_t start, std::size_t end, std::function<void(std::size_t index)> func,
-                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
-            wait_for_all(parallel_run_in_chunks<void>(
+        template<class Func>
+        void parallel_for(std::size_t start, std::size_t end, Func func,
+                          ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW,
+                          std::size_t min_chunk_size = AUTO_CHUNK_SIZE) {
+            if (end <= start)
+                return;
+            parallel_for_chunks(
                 end - start,
-                [start, func](std::size_t range_begin, std::size_t range_end) {
+                [start, &func](std::size_t range_begin, std::size_t range_end) {
                     for (std::size_t i = start + range_begin; i < start + range_end; i++) {
                         func(i);
                     }
-                }, pool_id));
+                }, pool_id, min_chunk_size);
         }
 
     }        // namespace crypto3
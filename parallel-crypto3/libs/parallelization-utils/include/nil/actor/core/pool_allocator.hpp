@@ -0,0 +1,258 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2024 Martun Karapetyan <martun@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_POOL_ALLOCATOR_HPP
+#define CRYPTO3_POOL_ALLOCATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <nil/actor/core/first_touch_allocator.hpp>
+
+namespace nil {
+    namespace crypto3 {
+
+        /**
+         * Process-wide pool of large memory blocks. A proof allocates and frees the same few sizes of vectors
+         * over and over, in each round and in each proof. Returning a freed block to the kernel and asking
+         * for it again costs an munmap, an mmap and a zeroing page fault on every page, so freed blocks are kept
+         * here and handed out again.
+         *
+         * The blocks are grouped by size classes, the powers of two. Most vectors of the prover have a power
+         * of two size, so there is no waste for them. At most 'max_cached_bytes' are kept, the rest goes back to
+         * the kernel. By default that is a quarter of the physical memory, so a cache full of the blocks of one
+         * proof does not push the blocks of the next one into the swap.
+         */
+        class buffer_pool {
+        public:
+            static buffer_pool& instance() {
+                // Never destroyed, vectors in static objects may be freed after the end of main.
+                static buffer_pool* pool = new buffer_pool();
+                return *pool;
+            }
+
+            // Returns a block of at least 'bytes' bytes. 'fresh' is set to true if the block comes from the kernel,
+            // it was never touched yet.
+            void* allocate(std::size_t bytes, bool& fresh) {
+                std::size_t size = size_class(bytes);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto it = free_blocks.find(size);
+                    if (it != free_blocks.end() && !it->second.empty()) {
+                        void* result = it->second.back();
+                        it->second.pop_back();
+                        cached_bytes -= size;
+                        fresh = false;
+                        return result;
+                    }
+                }
+                fresh = true;
+                return map_block(size);
+            }
+
+            void deallocate(void* p, std::size_t bytes) noexcept {
+                std::size_t size = size_class(bytes);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (cached_bytes + size <= max_cached_bytes) {
+                        try {
+                            free_blocks[size].push_back(p);
+                            cached_bytes += size;
+                            return;
+                        } catch (const std::bad_alloc&) {
+                            // No memory for the free list, the block goes back to the kernel.
+                        }
+                    }
+                }
+                unmap_block(p, size);
+            }
+
+            // Returns all the cached blocks to the kernel.
+            void release() {
+                std::map<std::size_t, std::vector<void*>> blocks;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    blocks.swap(free_blocks);
+                    cached_bytes = 0;
+                }
+                for (auto& [size, pointers] : blocks) {
+                    for (void* p : pointers) {
+                        unmap_block(p, size);
+                    }
+                }
+            }
+
+            // Returns the size of the blocks that are kept for reuse in bytes.
+            std::size_t get_cached_bytes() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return cached_bytes;
+            }
+
+            // Blocks freed above this limit are returned to the kernel. Does not release the blocks already cached.
+            void set_max_cached_bytes(std::size_t bytes) {
+                std::lock_guard<std::mutex> lock(mutex);
+                max_cached_bytes = bytes;
+            }
+
+            std::size_t get_max_cached_bytes() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return max_cached_bytes;
+            }
+
+            // Asks the kernel to back the new blocks with transparent 2 MiB huge pages. This saves the TLB misses
+            // of the random accesses of the FFTs, but the first touch of a block places its huge pages as a whole.
+            void set_use_huge_pages(bool value) {
+                use_huge_pages = value;
+            }
+
+            bool get_use_huge_pages() const {
+                return use_huge_pages;
+            }
+
+        private:
+            buffer_pool() : max_cached_bytes(default_max_cached_bytes()) {
+            }
+
+            static std::size_t default_max_cached_bytes() {
+#ifdef __linux__
+                long pages = sysconf(_SC_PHYS_PAGES);
+                long page_size = sysconf(_SC_PAGESIZE);
+                if (pages > 0 && page_size > 0) {
+                    return std::size_t(pages) * std::size_t(page_size) / 4;
+                }
+#endif
+                return std::size_t(1) << 30;
+            }
+
+            static std::size_t size_class(std::size_t bytes) {
+                std::size_t size = std::size_t(1) << 12;
+                while (size < bytes) {
+                    size <<= 1;
+                }
+                return size;
+            }
+
+            void* map_block(std::size_t size) {
+#ifdef __linux__
+                void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (memory == MAP_FAILED)
+                    throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+                if (use_huge_pages) {
+                    // Only a hint, the block is usable without huge pages.
+                    madvise(memory, size, MADV_HUGEPAGE);
+                }
+#endif
+                return memory;
+#else
+                return ::operator new(size);
+#endif
+            }
+
+            static void unmap_block(void* p, std::size_t size) noexcept {
+#ifdef __linux__
+                munmap(p, size);
+#else
+                ::operator delete(p);
+#endif
+            }
+
+            mutable std::mutex mutex;
+            std::map<std::size_t, std::vector<void*>> free_blocks;
+            std::size_t cached_bytes = 0;
+            std::size_t max_cached_bytes;
+            std::atomic<bool> use_huge_pages = false;
+        };
+
+        /**
+         * Allocator for large vectors that are freed and allocated again with the same sizes, like the columns of
+         * the extended domain in the prover. The blocks come from buffer_pool, so they are recycled between the
+         * rounds of a proof and between consecutive proofs. A new block is first touched like in
+         * first_touch_allocator, a recycled one keeps the placement of its pages.
+         *
+         * Blocks smaller than 'min_pooled_bytes' come from std::allocator.
+         */
+        template<typename T>
+        class pool_allocator {
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using propagate_on_container_move_assignment = std::true_type;
+            using is_always_equal = std::true_type;
+
+            static constexpr std::size_t min_pooled_bytes = std::size_t(1) << 21;
+
+            pool_allocator() noexcept = default;
+
+            template<typename U>
+            pool_allocator(const pool_allocator<U>&) noexcept {
+            }
+
+            T* allocate(std::size_t n) {
+                if (n * sizeof(T) < min_pooled_bytes)
+                    return std::allocator<T>().allocate(n);
+
+                bool fresh;
+                T* result = static_cast<T*>(buffer_pool::instance().allocate(n * sizeof(T), fresh));
+                if (fresh) {
+                    detail::first_touch_pages(result, n);
+                }
+                return result;
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                if (n * sizeof(T) < min_pooled_bytes) {
+                    std::allocator<T>().deallocate(p, n);
+                    return;
+                }
+                buffer_pool::instance().deallocate(p, n * sizeof(T));
+            }
+
+            template<typename U>
+            bool operator==(const pool_allocator<U>&) const noexcept {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const pool_allocator<U>&) const noexcept {
+                return false;
+            }
+        };
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_POOL_ALLOCATOR_HPP
@@ -25,77 +25,381 @@
 #ifndef CRYPTO3_THREAD_POOL_HPP
 #define CRYPTO3_THREAD_POOL_HPP
 
-#include <boost/asio/thread_pool.hpp>
-#include <boost/asio/post.hpp>
-
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <future>
-#include <thread>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace nil {
     namespace crypto3 {
 
+        namespace detail {
+
+            /**
+             * A unit of work understood by the scheduler. The scheduler only keeps pointers to tasks,
+             * the memory is owned by whoever submitted the task.
+             */
+            class pool_task {
+            public:
+                virtual ~pool_task() = default;
+                virtual void execute() = 0;
+            };
+
+            /**
+             * Task created by ThreadPool::post, owns a packaged task and deletes itself once executed.
+             */
+            template<class ReturnType>
+            class packaged_pool_task : public pool_task {
+            public:
+                explicit packaged_pool_task(std::function<ReturnType()> func)
+                    : task(std::move(func)) {
+                }
+
+                std::future<ReturnType> get_future() {
+                    return task.get_future();
+                }
+
+                void execute() override {
+                    task();
+                    delete this;
+                }
+
+            private:
+                std::packaged_task<ReturnType()> task;
+            };
+
+            /**
+             * Fixed capacity double-ended queue of tasks. The owning worker pushes and pops at the back,
+             * so it works on the most recently spawned (cache-hot) task, other threads steal from the front,
+             * taking the oldest and normally the largest pieces of work.
+             */
+            class task_deque {
+            public:
+                static constexpr std::size_t capacity = 1 << 12;
+
+                task_deque() : buffer(capacity) {
+                }
+
+                // Returns false if the deque is full, in which case the caller should run the task itself.
+                bool push_back(pool_task* task) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (count == capacity)
+                        return false;
+                    buffer[(head + count) % capacity] = task;
+                    ++count;
+                    return true;
+                }
+
+                pool_task* pop_back() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (count == 0)
+                        return nullptr;
+                    --count;
+                    return buffer[(head + count) % capacity];
+                }
+
+                pool_task* pop_front() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (count == 0)
+                        return nullptr;
+                    pool_task* task = buffer[head];
+                    head = (head + 1) % capacity;
+                    --count;
+                    return task;
+                }
+
+            private:
+                std::mutex mutex;
+                std::vector<pool_task*> buffer;
+                std::size_t head = 0;
+                std::size_t count = 0;
+            };
+
+        }    // namespace detail
+
+        /**
+         * Work-stealing task scheduler shared by all the parallel algorithms.
+         *
+         * Every worker owns a deque of tasks, tasks spawned from a worker go to its own deque, tasks posted from
+         * any other thread go to a shared injection queue. Idle workers steal from the other deques. A thread that
+         * waits for a result with ThreadPool::wait keeps executing pending tasks until the result is ready, so a task
+         * can spawn and wait for sub-tasks at any depth without blocking a worker and without deadlocks.
+         */
         class ThreadPool {
         public:
 
+            /**
+             * Historically we had a separate pool for each level of parallelism. Now all levels are served by the
+             * same scheduler, the level is only used as a hint for how finely the work must be split.
+             */
             enum class PoolLevel {
                 LOW,
                 HIGH,
                 LASTPOOL
             };
 
-            /** Returns a thread pool, based on the pool_id. pool with LOW is normally used for low-level operations, like polynomial
-             *  operations and fft. Any code that uses these operations and needs to be parallel will submit its tasks to pool with HIGH.
-             *  Submission of higher level tasks to low level pool will immediately result in a deadlock.
+            /** Returns the thread pool. 'pool_size' is the number of worker threads, it is only used on the first call.
+             *  'pool_id' is accepted for compatibility, all the levels share the same workers, so tasks of any level
+             *  can be submitted from any other task.
              */
-            static ThreadPool& get_instance(PoolLevel pool_id, std::size_t pool_size = std::thread::hardware_concurrency()) {
-                static ThreadPool instance_for_low_level(pool_size);
-                static ThreadPool instance_for_middle_level(pool_size);
-                static ThreadPool instance_for_high_level(pool_size);
-                
-                if (pool_id == PoolLevel::LOW)
-                    return instance_for_low_level;
-                if (pool_id == PoolLevel::HIGH)
-                    return instance_for_middle_level;
-                if (pool_id == PoolLevel::LASTPOOL)
-                    return instance_for_high_level;
+            static ThreadPool& get_instance(PoolLevel pool_id = PoolLevel::LOW,
+                                            std::size_t pool_size = std::thread::hardware_concurrency()) {
+                if (pool_id != PoolLevel::LOW && pool_id != PoolLevel::HIGH && pool_id != PoolLevel::LASTPOOL)
+                    throw std::invalid_argument("Invalid instance of thread pool requested.");
 
-                throw std::invalid_argument("Invalid instance of thread pool requested.");
+                static ThreadPool instance(pool_size);
+                return instance;
             }
 
             ThreadPool(const ThreadPool& obj)= delete;
             ThreadPool& operator=(const ThreadPool& obj)= delete;
 
+            ~ThreadPool() {
+                stop_workers();
+            }
+
             template<class ReturnType>
             inline std::future<ReturnType> post(std::function<ReturnType()> task) {
-                auto packaged_task = std::make_shared<std::packaged_task<ReturnType()>>(std::move(task));
-                std::future<ReturnType> fut = packaged_task->get_future();
-                boost::asio::post(pool, [packaged_task]() -> void { (*packaged_task)(); });
+                auto* pool_task = new detail::packaged_pool_task<ReturnType>(std::move(task));
+                std::future<ReturnType> fut = pool_task->get_future();
+                submit(pool_task);
                 return fut;
             }
- 
+
+            /**
+             * Schedules a task for execution. If the queue of the calling thread is full the task is executed
+             * immediately.
+             */
+            void submit(detail::pool_task* task) {
+                pending_tasks.fetch_add(1);
+
+                bool pushed = (current_worker_index() != no_worker)
+                    ? worker_queues[current_worker_index()]->push_back(task)
+                    : injection_queue.push_back(task);
+                if (!pushed) {
+                    run_task(task);
+                    return;
+                }
+
+                queued_tasks.fetch_add(1);
+                if (sleeping_workers.load() > 0) {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    sleep_condition.notify_one();
+                }
+            }
+
+            /**
+             * Waits for the future to be ready, executing other pending tasks in the meantime.
+             * Must be used instead of future::get whenever the caller itself may run inside the pool.
+             */
+            template<class ReturnType>
+            ReturnType wait(std::future<ReturnType>& fut) {
+                help_until([&fut]() {
+                    return fut.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                });
+                return fut.get();
+            }
+
+            /**
+             * Executes pending tasks on the calling thread until 'is_done' returns true.
+             */
+            template<class Predicate>
+            void help_until(Predicate is_done) {
+                std::size_t idle_rounds = 0;
+                while (!is_done()) {
+                    if (try_run_pending_task()) {
+                        ++helped_tasks();
+                        idle_rounds = 0;
+                        continue;
+                    }
+                    // Whatever we wait for is being executed by some other thread, back off a bit.
+                    if (++idle_rounds < 64) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    }
+                }
+            }
+
+            /**
+             * Restarts the workers with the new configuration. If 'pool_size' is 0, one worker per CPU from 'cpu_list'
+             * is created, or hardware_concurrency() workers if the list is empty. If 'cpu_list' is not empty,
+             * worker i is pinned to CPU cpu_list[i % cpu_list.size()]. Waits for the pending tasks before the restart.
+             * Must be called from outside of the pool, while no other thread is submitting tasks.
+             */
+            void configure(std::size_t new_pool_size, const std::vector<std::size_t>& new_cpu_list = {}) {
+                if (current_worker_index() != no_worker)
+                    throw std::logic_error("Thread pool can not be reconfigured from inside of its own task.");
+
+                if (new_pool_size == 0)
+                    new_pool_size = new_cpu_list.empty() ? std::thread::hardware_concurrency() : new_cpu_list.size();
+
+                join();
+                stop_workers();
+                pool_size = std::max(std::size_t(1), new_pool_size);
+                cpu_list = new_cpu_list;
+                start_workers();
+            }
+
             // Waits for all the tasks to complete.
             inline void join() {
-                pool.join();
+                help_until([this]() { return pending_tasks.load() == 0; });
             }
 
             std::size_t get_pool_size() const {
                 return pool_size;
             }
 
+            // Returns the number of tasks the calling thread has executed in help_until so far. The time of a piece
+            // of work that waited also contains these tasks, which may belong to any other work.
+            static std::size_t get_helped_tasks_count() {
+                return helped_tasks();
+            }
+
         private:
+            static constexpr std::size_t no_worker = std::numeric_limits<std::size_t>::max();
+
             inline ThreadPool(std::size_t pool_size)
-                : pool(pool_size)
-                , pool_size(pool_size)  {
+                : pool_size(std::max(std::size_t(1), pool_size)) {
+                start_workers();
+            }
+
+            static std::size_t& current_worker_index() {
+                static thread_local std::size_t index = no_worker;
+                return index;
+            }
+
+            static std::size_t& helped_tasks() {
+                static thread_local std::size_t count = 0;
+                return count;
             }
 
-            boost::asio::thread_pool pool;
-            const std::size_t pool_size;
+            void start_workers() {
+                stopping = false;
+                worker_queues.clear();
+                for (std::size_t i = 0; i < pool_size; ++i) {
+                    worker_queues.emplace_back(std::make_unique<detail::task_deque>());
+                }
+                for (std::size_t i = 0; i < pool_size; ++i) {
+                    workers.emplace_back([this, i]() { worker_loop(i); });
+                }
+                if (!cpu_list.empty()) {
+                    for (std::size_t i = 0; i < pool_size; ++i) {
+                        pin_thread(workers[i], cpu_list[i % cpu_list.size()]);
+                    }
+                }
+            }
+
+            static void pin_thread(std::thread& thread, std::size_t cpu) {
+#ifdef __linux__
+                if (cpu >= CPU_SETSIZE)
+                    throw std::invalid_argument("CPU index " + std::to_string(cpu) + " is out of range.");
+                cpu_set_t cpu_set;
+                CPU_ZERO(&cpu_set);
+                CPU_SET(cpu, &cpu_set);
+                if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set) != 0)
+                    throw std::runtime_error("Failed to pin a worker thread to CPU " + std::to_string(cpu) + ".");
+#else
+                throw std::logic_error("Pinning of worker threads is only supported on Linux.");
+#endif
+            }
+
+            void stop_workers() {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    stopping = true;
+                }
+                sleep_condition.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                workers.clear();
+            }
+
+            void run_task(detail::pool_task* task) {
+                task->execute();
+                pending_tasks.fetch_sub(1);
+            }
+
+            detail::pool_task* take_task() {
+                const std::size_t own_index = current_worker_index();
+                detail::pool_task* task = nullptr;
+                if (own_index != no_worker) {
+                    task = worker_queues[own_index]->pop_back();
+                }
+                if (task == nullptr) {
+                    task = injection_queue.pop_front();
+                }
+                // Steal from the other workers, starting from the next one, so the thieves spread out.
+                const std::size_t start = (own_index == no_worker) ? 0 : own_index + 1;
+                for (std::size_t i = 0; task == nullptr && i < worker_queues.size(); ++i) {
+                    const std::size_t victim = (start + i) % worker_queues.size();
+                    if (victim != own_index) {
+                        task = worker_queues[victim]->pop_front();
+                    }
+                }
+                if (task != nullptr) {
+                    queued_tasks.fetch_sub(1);
+                }
+                return task;
+            }
+
+            bool try_run_pending_task() {
+                detail::pool_task* task = take_task();
+                if (task == nullptr)
+                    return false;
+                run_task(task);
+                return true;
+            }
+
+            void worker_loop(std::size_t index) {
+                current_worker_index() = index;
+                while (true) {
+                    if (try_run_pending_task())
+                        continue;
+
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    sleeping_workers.fetch_add(1);
+                    sleep_condition.wait(lock, [this]() { return stopping || queued_tasks.load() > 0; });
+                    sleeping_workers.fetch_sub(1);
+                    if (stopping && queued_tasks.load() == 0)
+                        break;
+                }
+                current_worker_index() = no_worker;
+            }
+
+            std::size_t pool_size;
+            // CPUs the workers are pinned to, empty if the workers are not pinned.
+            std::vector<std::size_t> cpu_list;
+
+            std::vector<std::unique_ptr<detail::task_deque>> worker_queues;
+            detail::task_deque injection_queue;
+            std::vector<std::thread> workers;
+
+            // Tasks submitted but not finished yet, including the ones being executed.
+            std::atomic<std::size_t> pending_tasks = 0;
+            // Tasks sitting in one of the queues.
+            std::atomic<std::size_t> queued_tasks = 0;
+            std::atomic<std::size_t> sleeping_workers = 0;
 
+            std::mutex sleep_mutex;
+            std::condition_variable sleep_condition;
+            bool stopping = false;
         };
 
     }        // namespace crypto3
@@ -25,13 +25,27 @@
 
 #define BOOST_TEST_MODULE thread_pool_test
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include <sched.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
 
+#include <nil/actor/core/cpu_list.hpp>
+#include <nil/actor/core/first_touch_allocator.hpp>
+#include <nil/actor/core/mapped_file_allocator.hpp>
+#include <nil/actor/core/pool_allocator.hpp>
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
 
@@ -61,4 +75,293 @@ BOOST_AUTO_TEST_CASE(vector_multiplication_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(nested_parallelism_test) {
+    // Each outer task runs an inner parallel loop on the same pool level, which used to deadlock
+    // once all the workers of a pool were waiting for their own sub-tasks.
+    std::size_t outer_size = 64;
+    std::size_t inner_size = 1 << 14;
+
+    std::vector<std::vector<std::size_t>> v(outer_size, std::vector<std::size_t>(inner_size));
+
+    nil::crypto3::parallel_for(0, outer_size,
+        [&v, inner_size](std::size_t i) {
+            nil::crypto3::parallel_for(0, inner_size,
+                [&v, i](std::size_t j) {
+                    v[i][j] = i * j;
+                }, nil::crypto3::ThreadPool::PoolLevel::LOW);
+        }, nil::crypto3::ThreadPool::PoolLevel::LOW);
+
+    for (std::size_t i = 0; i < outer_size; ++i) {
+        for (std::size_t j = 0; j < inner_size; ++j) {
+            BOOST_CHECK_EQUAL(v[i][j], i * j);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(exception_propagation_test) {
+    BOOST_CHECK_THROW(
+        nil::crypto3::wait_for_all(nil::crypto3::parallel_run_in_chunks<void>(
+            1 << 14,
+            [](std::size_t begin, std::size_t end) {
+                if (begin == 0)
+                    throw std::runtime_error("Failure inside a task.");
+            }, nil::crypto3::ThreadPool::PoolLevel::HIGH)),
+        std::runtime_error);
+
+    // The pool must stay usable after a task has thrown.
+    std::vector<std::size_t> sums = nil::crypto3::wait_for_all(nil::crypto3::parallel_run_in_chunks<std::size_t>(
+        1000,
+        [](std::size_t begin, std::size_t end) {
+            std::size_t sum = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                sum += i;
+            return sum;
+        }));
+    BOOST_CHECK_EQUAL(std::accumulate(sums.begin(), sums.end(), std::size_t(0)), 999 * 1000 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_chunks_test) {
+    std::size_t size = 100000;
+    std::vector<std::size_t> v(size, 0);
+
+    nil::crypto3::parallel_for_chunks(
+        size,
+        [&v](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                v[i] += i + 1;
+            }
+        }, nil::crypto3::ThreadPool::PoolLevel::HIGH);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        BOOST_CHECK_EQUAL(v[i], i + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_chunks_min_chunk_size_test) {
+    std::size_t size = 100000;
+    std::size_t min_chunk_size = 30000;
+    std::vector<std::size_t> v(size, 0);
+    std::atomic<std::size_t> chunks = 0;
+
+    nil::crypto3::parallel_for_chunks(
+        size,
+        [&v, &chunks, min_chunk_size](std::size_t begin, std::size_t end) {
+            BOOST_CHECK(end - begin >= min_chunk_size);
+            for (std::size_t i = begin; i < end; ++i) {
+                v[i] += i + 1;
+            }
+            ++chunks;
+        }, nil::crypto3::ThreadPool::PoolLevel::HIGH, min_chunk_size);
+
+    BOOST_CHECK(chunks <= size / min_chunk_size);
+    for (std::size_t i = 0; i < size; ++i) {
+        BOOST_CHECK_EQUAL(v[i], i + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chunk_size_tuner_test) {
+    nil::crypto3::detail::chunk_size_tuner tuner;
+    BOOST_CHECK_EQUAL(tuner.min_chunk_size(123), 123);
+
+    // 1 microsecond per element, so a chunk of 100 elements runs for the target 100 microseconds.
+    tuner.record(1000, std::chrono::milliseconds(1));
+    BOOST_CHECK_EQUAL(tuner.min_chunk_size(123), 100);
+
+    // Elements slower than the target time of a whole chunk still make chunks of one element.
+    nil::crypto3::detail::chunk_size_tuner slow_tuner;
+    slow_tuner.record(1, std::chrono::seconds(1));
+    BOOST_CHECK_EQUAL(slow_tuner.min_chunk_size(123), 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_reduce_test) {
+    std::size_t size = 1 << 16;
+    std::vector<std::size_t> v(size);
+    std::iota(v.begin(), v.end(), 0);
+
+    // Concatenation is associative, but not commutative, so this also checks the order of the chunks.
+    std::vector<std::size_t> concatenated = nil::crypto3::parallel_reduce(
+        size, std::vector<std::size_t>(),
+        [&v](std::size_t begin, std::size_t end) {
+            return std::vector<std::size_t>(v.begin() + begin, v.begin() + end);
+        },
+        [](std::vector<std::size_t> a, std::vector<std::size_t> b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        }, nil::crypto3::ThreadPool::PoolLevel::HIGH);
+
+    BOOST_CHECK(concatenated == v);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_invoke_test) {
+    std::size_t a = 0, b = 0, c = 0;
+    nil::crypto3::parallel_invoke(
+        [&a]() { a = 1; },
+        [&b]() { b = 2; },
+        [&c]() { c = 3; });
+
+    BOOST_CHECK_EQUAL(a, 1);
+    BOOST_CHECK_EQUAL(b, 2);
+    BOOST_CHECK_EQUAL(c, 3);
+
+    BOOST_CHECK_THROW(
+        nil::crypto3::parallel_invoke(
+            []() {},
+            []() { throw std::runtime_error("Failure inside a forked task."); }),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_inclusive_scan_test) {
+    std::size_t size = 100003;
+    std::vector<std::size_t> v(size);
+    for (std::size_t i = 0; i < size; ++i)
+        v[i] = i % 7;
+
+    std::vector<std::size_t> expected(size);
+    std::inclusive_scan(v.begin(), v.end(), expected.begin());
+
+    std::vector<std::size_t> result(size);
+    nil::crypto3::parallel_inclusive_scan(v.begin(), v.end(), result.begin(), std::plus<std::size_t>());
+    BOOST_CHECK(result == expected);
+
+    // In-place scan.
+    nil::crypto3::parallel_inclusive_scan(v.begin(), v.end(), v.begin(), std::plus<std::size_t>(),
+                                          nil::crypto3::ThreadPool::PoolLevel::HIGH);
+    BOOST_CHECK(v == expected);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_sort_test) {
+    std::mt19937_64 gen(42);
+    std::size_t size = 200000;
+    std::vector<std::uint64_t> v(size);
+    for (std::size_t i = 0; i < size; ++i)
+        // Lots of duplicates.
+        v[i] = gen() % 1000;
+
+    std::vector<std::uint64_t> expected = v;
+    std::sort(expected.begin(), expected.end());
+
+    nil::crypto3::parallel_sort(v.begin(), v.end(), nil::crypto3::ThreadPool::PoolLevel::HIGH);
+    BOOST_CHECK(v == expected);
+
+    std::vector<std::uint64_t> w(size);
+    for (std::size_t i = 0; i < size; ++i)
+        w[i] = gen();
+    expected = w;
+    std::sort(expected.begin(), expected.end(), std::greater<std::uint64_t>());
+
+    nil::crypto3::parallel_sort(w.begin(), w.end(), std::greater<std::uint64_t>());
+    BOOST_CHECK(w == expected);
+}
+
+BOOST_AUTO_TEST_CASE(parse_cpu_list_test) {
+    BOOST_CHECK(nil::crypto3::parse_cpu_list("") == std::vector<std::size_t>());
+    BOOST_CHECK(nil::crypto3::parse_cpu_list("3") == std::vector<std::size_t>({3}));
+    BOOST_CHECK(nil::crypto3::parse_cpu_list("0-3, 8,10-11") == std::vector<std::size_t>({0, 1, 2, 3, 8, 10, 11}));
+
+    BOOST_CHECK_THROW(nil::crypto3::parse_cpu_list("3-1"), std::invalid_argument);
+    BOOST_CHECK_THROW(nil::crypto3::parse_cpu_list("a-b"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_allocator_test) {
+    // One vector below the first touch threshold, one above it.
+    for (std::size_t size : {std::size_t(1) << 10, std::size_t(1) << 20}) {
+        std::vector<std::uint64_t, nil::crypto3::first_touch_allocator<std::uint64_t>> v(size, 3);
+        nil::crypto3::parallel_foreach(v.begin(), v.end(), [](std::uint64_t& x) { x *= 2; });
+        BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::uint64_t(0)), 6 * size);
+
+        v.resize(2 * size, 1);
+        BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::uint64_t(0)), 7 * size);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mapped_file_allocator_test) {
+    auto& storage = nil::crypto3::mapped_file_storage::instance();
+    std::size_t mapped_bytes = storage.get_mapped_bytes();
+
+    BOOST_CHECK(!storage.get_sequential_access());
+
+    // One vector below the mapping threshold, one above it, with both kinds of advice.
+    for (bool sequential : {false, true}) {
+        storage.set_sequential_access(sequential);
+        for (std::size_t size : {std::size_t(1) << 10, std::size_t(1) << 20}) {
+            std::vector<std::uint64_t, nil::crypto3::mapped_file_allocator<std::uint64_t>> v(size, 3);
+            nil::crypto3::parallel_foreach(v.begin(), v.end(), [](std::uint64_t& x) { x *= 2; });
+            BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::uint64_t(0)), 6 * size);
+        }
+    }
+    storage.set_sequential_access(false);
+    BOOST_CHECK_EQUAL(storage.get_mapped_bytes(), mapped_bytes);
+}
+
+BOOST_AUTO_TEST_CASE(pool_allocator_test) {
+    using vector_type = std::vector<std::uint64_t, nil::crypto3::pool_allocator<std::uint64_t>>;
+    auto& pool = nil::crypto3::buffer_pool::instance();
+    pool.release();
+
+    const std::size_t size = std::size_t(1) << 20;
+    const std::uint64_t* data;
+    {
+        vector_type v(size, 3);
+        data = v.data();
+        BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::uint64_t(0)), 3 * size);
+    }
+    BOOST_CHECK_EQUAL(pool.get_cached_bytes(), size * sizeof(std::uint64_t));
+
+    // The freed block is handed out again.
+    {
+        vector_type v(size, 5);
+        BOOST_CHECK_EQUAL(v.data(), data);
+        BOOST_CHECK_EQUAL(pool.get_cached_bytes(), 0);
+        BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::uint64_t(0)), 5 * size);
+    }
+
+    // The cache is bounded by default.
+    const std::size_t max_cached_bytes = pool.get_max_cached_bytes();
+    BOOST_CHECK(max_cached_bytes > 0);
+    BOOST_CHECK(max_cached_bytes < std::numeric_limits<std::size_t>::max());
+
+    pool.set_max_cached_bytes(0);
+    {
+        vector_type v(size, 1);
+    }
+    BOOST_CHECK_EQUAL(pool.get_cached_bytes(), 0);
+    pool.set_max_cached_bytes(max_cached_bytes);
+    pool.release();
+}
+
+// The first CPU the process may run on, CPU 0 can be outside of the affinity mask under taskset or in a container.
+std::size_t first_allowed_cpu() {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    BOOST_REQUIRE(sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0);
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpu_set))
+            return cpu;
+    }
+    BOOST_FAIL("The affinity mask of the process is empty");
+    return 0;
+}
+
+BOOST_AUTO_TEST_CASE(configure_test) {
+    auto& thread_pool = nil::crypto3::ThreadPool::get_instance(nil::crypto3::ThreadPool::PoolLevel::LOW);
+    std::size_t initial_pool_size = thread_pool.get_pool_size();
+    const std::size_t cpu = first_allowed_cpu();
+
+    // All the workers pinned to the same CPU.
+    thread_pool.configure(3, {cpu});
+    BOOST_CHECK_EQUAL(thread_pool.get_pool_size(), 3);
+
+    std::size_t size = 1 << 16;
+    std::vector<std::size_t> v(size, 1);
+    nil::crypto3::parallel_foreach(v.begin(), v.end(), [](std::size_t& x) { x *= 2; },
+                                   nil::crypto3::ThreadPool::PoolLevel::HIGH);
+    BOOST_CHECK_EQUAL(std::accumulate(v.begin(), v.end(), std::size_t(0)), 2 * size);
+
+    thread_pool.configure(0, {cpu, cpu});
+    BOOST_CHECK_EQUAL(thread_pool.get_pool_size(), 2);
+
+    thread_pool.configure(initial_pool_size);
+    BOOST_CHECK_EQUAL(thread_pool.get_pool_size(), initial_pool_size);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
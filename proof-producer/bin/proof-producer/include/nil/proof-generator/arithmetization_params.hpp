@@ -35,6 +35,16 @@ namespace nil {
                                       // Add more curves as needed.
                                       >;
 
+        // C++ name of the base field of a curve and its header, for the printed gate evaluators.
+        template<typename CurveType>
+        struct curve_base_field_name;
+
+        template<>
+        struct curve_base_field_name<nil::crypto3::algebra::curves::pallas> {
+            static constexpr const char* field_type = "nil::crypto3::algebra::curves::pallas::base_field_type";
+            static constexpr const char* include = "nil/crypto3/algebra/curves/pallas.hpp";
+        };
+
         using HashTypes = std::tuple<
             nil::crypto3::hashes::keccak_1600<256>,
             nil::crypto3::hashes::sha2<256>,
@@ -58,6 +58,7 @@
 
 #include <nil/blueprint/transpiler/recursive_verifier_generator.hpp>
 #include <nil/blueprint/transpiler/lpc_evm_verifier_gen.hpp>
+#include <nil/blueprint/transpiler/gates_evaluator_cpp_gen.hpp>
 
 #include <nil/proof-generator/preset/preset.hpp>
 #include <nil/proof-generator/assigner/assigner.hpp>
@@ -207,6 +208,28 @@ namespace nil {
                 return true;
             }
 
+            // Prints the gate evaluator of the circuit, the multi-threaded prover uses it for the circuit when it
+            // is built in, see PROOF_PRODUCER_GATES_EVALUATORS. Needs the public preprocessed data.
+            bool print_gates_evaluator(
+                boost::filesystem::path output_file
+            ){
+                if( output_file.empty() ) return true;
+#ifdef PROOF_GENERATOR_MULTI_THREADED
+                BOOST_LOG_TRIVIAL(info) << "Print gates evaluator to " << output_file;
+                nil::blueprint::gates_evaluator_cpp_printer<PlaceholderParams> gates_evaluator_printer(
+                    *constraint_system_,
+                    nil::crypto3::zk::snark::compiled_gates_evaluators<BlueprintField>::key(
+                        public_preprocessed_data_->common_data.vk.constraint_system_with_params_hash),
+                    curve_base_field_name<CurveType>::field_type,
+                    {curve_base_field_name<CurveType>::include}
+                );
+                gates_evaluator_printer.print(output_file.string());
+#else
+                BOOST_LOG_TRIVIAL(warning) << "Gate evaluators are used only by the multi-threaded prover, not printing one";
+#endif
+                return true;
+            }
+
             bool print_public_input_for_evm(
                 boost::filesystem::path output_folder
             ){
@@ -93,7 +93,17 @@ namespace nil {
                 ("grind-param", make_defaulted_option(prover_options.grind), "Grind param (0)")
                 ("expand-factor,x", make_defaulted_option(prover_options.expand_factor), "Expand factor")
                 ("max-quotient-chunks,q", make_defaulted_option(prover_options.max_quotient_chunks), "Maximum quotient polynomial parts amount")
+                ("threads", make_defaulted_option(prover_options.threads),
+                 "Number of worker threads of the multi-threaded prover, 0 means one per CPU from 'cpu-list' or one per available CPU")
+                ("cpu-list", po::value(&prover_options.cpu_list),
+                 "CPUs to pin the worker threads of the multi-threaded prover to, like '0-7,16-23'. 'node<N>' selects all CPUs of NUMA node N")
+                ("huge-pages", po::bool_switch(&prover_options.huge_pages),
+                 "Back the pooled buffers of the multi-threaded prover with transparent huge pages")
+                ("buffer-pool-size", make_defaulted_option(prover_options.buffer_pool_size),
+                 "Size in MiB of the freed buffers kept for reuse by the multi-threaded prover, 0 means a quarter of the physical memory")
                 ("evm-verifier", make_defaulted_option(prover_options.evm_verifier_path), "Output folder for EVM verifier")
+                ("gates-evaluator", make_defaulted_option(prover_options.gates_evaluator_path),
+                 "Output file for the C++ gate evaluator of the circuit, built into the multi-threaded prover with PROOF_PRODUCER_GATES_EVALUATORS")
                 ("input-challenge-files,u", po::value<std::vector<boost::filesystem::path>>(&prover_options.input_challenge_files)->multitoken(),
                  "Input challenge files. Used with 'generate-aggregated-challenge' stage.")
                 ("challenge-file", po::value<boost::filesystem::path>(&prover_options.challenge_file_path),
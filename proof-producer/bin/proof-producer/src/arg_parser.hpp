@@ -51,6 +51,7 @@ namespace nil {
             boost::filesystem::path challenge_file_path;
             boost::filesystem::path theta_power_file_path;
             boost::filesystem::path evm_verifier_path;
+            boost::filesystem::path gates_evaluator_path;
             std::vector<boost::filesystem::path> input_challenge_files;
             std::vector<boost::filesystem::path> partial_proof_files;
             std::vector<boost::filesystem::path> initial_proof_files;
@@ -71,6 +72,10 @@ namespace nil {
             std::size_t grind = 0;
             std::size_t expand_factor = 2;
             std::size_t max_quotient_chunks = 0;
+            std::size_t threads = 0;
+            std::string cpu_list;
+            bool huge_pages = false;
+            std::size_t buffer_pool_size = 0;
         };
 
         std::optional<ProverOptions> parse_args(int argc, char* argv[]);
@@ -25,6 +25,12 @@
 #include <nil/proof-generator/file_operations.hpp>
 #include <nil/proof-generator/prover.hpp>
 
+#ifdef PROOF_GENERATOR_MULTI_THREADED
+#include <nil/actor/core/cpu_list.hpp>
+#include <nil/actor/core/pool_allocator.hpp>
+#include <nil/actor/core/thread_pool.hpp>
+#endif
+
 #undef B0
 
 using namespace nil::proof_generator;
@@ -57,7 +63,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.save_preprocessed_common_data_to_file(prover_options.preprocessed_common_data_path) &&
                         prover.save_public_preprocessed_data_to_file(prover_options.preprocessed_public_data_path) &&
                         prover.save_commitment_state_to_file(prover_options.commitment_scheme_state_path) &&
-                        prover.print_evm_verifier(prover_options.evm_verifier_path);
+                        prover.print_evm_verifier(prover_options.evm_verifier_path) &&
+                        prover.print_gates_evaluator(prover_options.gates_evaluator_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::PRESET:
                     prover_result = prover.setup_prover();
@@ -91,7 +98,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.save_public_preprocessed_data_to_file(prover_options.preprocessed_public_data_path) &&
                         prover.save_commitment_state_to_file(prover_options.commitment_scheme_state_path)&&
                         prover.save_assignment_description(prover_options.assignment_description_file_path) &&
-                        prover.print_evm_verifier(prover_options.evm_verifier_path);
+                        prover.print_evm_verifier(prover_options.evm_verifier_path) &&
+                        prover.print_gates_evaluator(prover_options.gates_evaluator_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::PROVE:
                     // Load preprocessed data from file and generate the proof.
@@ -222,7 +230,50 @@ int curve_wrapper(const ProverOptions& prover_options) {
     return ret;
 }
 
+// Sets up the worker threads before any parallel code runs. Options are ignored by the single-threaded prover.
+bool configure_thread_pool(const ProverOptions& prover_options) {
+#ifdef PROOF_GENERATOR_MULTI_THREADED
+    if (prover_options.threads == 0 && prover_options.cpu_list.empty()) {
+        return true;
+    }
+    try {
+        nil::crypto3::ThreadPool::get_instance().configure(
+            prover_options.threads, nil::crypto3::parse_cpu_list(prover_options.cpu_list));
+    } catch (const std::exception& e) {
+        BOOST_LOG_TRIVIAL(error) << "Failed to configure worker threads: " << e.what();
+        return false;
+    }
+    BOOST_LOG_TRIVIAL(info) << "Using " << nil::crypto3::ThreadPool::get_instance().get_pool_size() << " worker threads";
+#else
+    if (prover_options.threads != 0 || !prover_options.cpu_list.empty()) {
+        BOOST_LOG_TRIVIAL(warning) << "Options 'threads' and 'cpu-list' are ignored by the single-threaded prover";
+    }
+#endif
+    return true;
+}
+
+// Sets up the pool of the large temporary buffers, see nil::crypto3::buffer_pool.
+void configure_buffer_pool(const ProverOptions& prover_options) {
+#ifdef PROOF_GENERATOR_MULTI_THREADED
+    auto& pool = nil::crypto3::buffer_pool::instance();
+    pool.set_use_huge_pages(prover_options.huge_pages);
+    if (prover_options.buffer_pool_size != 0) {
+        pool.set_max_cached_bytes(prover_options.buffer_pool_size << 20);
+    }
+    BOOST_LOG_TRIVIAL(info) << "Keeping up to " << (pool.get_max_cached_bytes() >> 20)
+                            << " MiB of freed buffers for reuse" << (pool.get_use_huge_pages() ? ", using huge pages" : "");
+#else
+    if (prover_options.huge_pages || prover_options.buffer_pool_size != 0) {
+        BOOST_LOG_TRIVIAL(warning) << "Options 'huge-pages' and 'buffer-pool-size' are ignored by the single-threaded prover";
+    }
+#endif
+}
+
 int initial_wrapper(const ProverOptions& prover_options) {
+    if (!configure_thread_pool(prover_options)) {
+        return 1;
+    }
+    configure_buffer_pool(prover_options);
     return curve_wrapper(prover_options);
 }
 